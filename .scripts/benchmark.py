@@ -0,0 +1,65 @@
+import json
+
+import click
+
+METRICS = ["cycles", "max_cycles", "bytes"]
+
+
+def parse_output(output):
+    # Keep the lines printed by the benchmark sketch
+    results = {}
+    for line in output.splitlines():
+        line = line.strip()
+        if not line.startswith("{"):
+            continue
+        try:
+            data = json.loads(line)
+        except ValueError:
+            continue
+        if "benchmark" in data:
+            results[data.pop("benchmark")] = data
+
+    return results
+
+
+def find_regressions(results, baseline, tolerance):
+    regressions = []
+    for name, expected in baseline.items():
+        actual = results.get(name)
+        if actual is None:
+            regressions.append(f"{name}: missing")
+            continue
+        for metric in METRICS:
+            if metric not in expected:
+                continue
+            limit = expected[metric] * (1 + tolerance / 100)
+            if actual[metric] > limit:
+                regressions.append(
+                    f"{name}.{metric}: {actual[metric]} > {expected[metric]} (+{tolerance}%)"
+                )
+
+    return regressions
+
+
+@click.command()
+@click.argument("filename", required=False, type=click.File("r"), default="-")
+@click.option("--baseline", type=click.File("r"), help="Results to compare with.")
+@click.option("--tolerance", default=5.0, help="Allowed increase in percent.")
+def main(filename, baseline, tolerance):
+    output = filename.read()
+
+    results = parse_output(output)
+    if not results:
+        raise click.ClickException("no benchmark results found")
+    click.echo(json.dumps(results, indent=2))
+
+    if baseline is not None:
+        regressions = find_regressions(results, json.load(baseline), tolerance)
+        for regression in regressions:
+            click.echo(f"Regression {regression}", err=True)
+        if regressions:
+            raise SystemExit(1)
+
+
+if __name__ == "__main__":
+    main()
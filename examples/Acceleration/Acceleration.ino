@@ -0,0 +1,63 @@
+/*
+ Accelerated Progress
+
+ Holding LEFT or RIGHT on the keyboard repeats the key, the progress then
+ moves faster and faster. The progress is redrawn at most 20 times per
+ second, poll() draws the last change.
+
+*/
+#include <ItemProgress.h>
+#include <LcdMenu.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// Configure keyboard keys (ASCII)
+#define UP 56     // NUMPAD 8
+#define DOWN 50   // NUMPAD 2
+#define LEFT 52   // NUMPAD 4
+#define RIGHT 54  // NUMPAD 6
+#define ENTER 53  // NUMPAD 5
+#define BACK 55   // NUMPAD 7
+
+void frequencyCallback(uint16_t value);
+
+MAIN_MENU(
+    ITEM_PROGRESS("Freq", 0, frequencyCallback),
+    ITEM_BASIC("About")
+);
+
+LcdMenu menu(LCD_ROWS, LCD_COLS);
+
+void setup() {
+    Serial.begin(9600);
+    menu.setupLcdWithMenu(0x27, mainMenu);
+    // Repeats less than 150ms apart speed up the progress
+    menu.setAcceleration(150);
+    // Redraw the progress at most every 50ms
+    menu.setProgressRefreshInterval(50);
+}
+
+void loop() {
+    menu.poll();
+    if (!Serial.available()) return;
+    char command = Serial.read();
+
+    if (command == UP)
+        menu.up();
+    else if (command == DOWN)
+        menu.down();
+    else if (command == LEFT)
+        menu.left();
+    else if (command == RIGHT)
+        menu.right();
+    else if (command == ENTER)
+        menu.enter();
+    else if (command == BACK)
+        menu.back();
+}
+
+void frequencyCallback(uint16_t value) {
+    Serial.print(F("Frequency: "));
+    Serial.println(value);
+}
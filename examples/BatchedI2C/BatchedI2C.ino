@@ -0,0 +1,59 @@
+/*
+ Batched I2C
+
+ The menu is sent to a PCF8574 backpack with a few large I2C transmissions
+ at 400kHz instead of three transmissions per nibble.
+
+*/
+
+// Use the batched driver instead of LiquidCrystal_I2C
+#define USE_BATCHED_LCD_I2C
+#include <LcdMenu.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// Configure keyboard keys (ASCII)
+#define UP 56        // NUMPAD 8
+#define DOWN 50      // NUMPAD 2
+#define LEFT 52      // NUMPAD 4
+#define RIGHT 54     // NUMPAD 6
+#define ENTER 53     // NUMPAD 5
+#define BACK 55      // NUMPAD 7
+#define BACKSPACE 8  // BACKSPACE
+#define CLEAR 46     // NUMPAD .
+
+// Initialize the main menu items
+MAIN_MENU(
+    ITEM_BASIC("Start service"),
+    ITEM_BASIC("Connect to WiFi"),
+    ITEM_BASIC("Settings"),
+    ITEM_BASIC("Blink SOS"),
+    ITEM_BASIC("Blink random")
+);
+// Construct the LcdMenu
+LcdMenu menu(LCD_ROWS, LCD_COLS);
+
+void setup() {
+    Serial.begin(9600);
+    // Initialize LcdMenu with the menu items
+    menu.setupLcdWithMenu(0x27, mainMenu);
+}
+
+void loop() {
+    if (!Serial.available()) return;
+    char command = Serial.read();
+
+    if (command == UP)
+        menu.up();
+    else if (command == DOWN)
+        menu.down();
+    else if (command == LEFT)
+        menu.left();
+    else if (command == RIGHT)
+        menu.right();
+    else if (command == ENTER)
+        menu.enter();
+    else if (command == BACK)
+        menu.back();
+}
\ No newline at end of file
@@ -0,0 +1,281 @@
+/*
+ Benchmark
+
+ Runs a scripted navigation through the menu and reports the cost of each
+ step over Serial, one JSON object per line:
+
+   {"benchmark":"scroll","calls":18,"cycles":123456,"max_cycles":9876,
+    "us":7716,"max_us":617,"bytes":210}
+
+ - `cycles` / `us`: total time spent in the calls of the step
+ - `max_cycles` / `max_us`: time of the slowest call
+ - `bytes`: characters and commands sent to the display
+
+ On AVR the time is counted in CPU cycles with Timer1, elsewhere it is
+ derived from micros(). The output can be checked against a baseline with
+ .scripts/benchmark.py.
+
+*/
+
+#include <ItemInput.h>
+#include <ItemProgress.h>
+#include <ItemSubMenu.h>
+#include <ItemToggle.h>
+#include <GenericLcdMenu.h>
+#ifdef USE_BATCHED_LCD_I2C
+#include <BatchedLcdI2C.h>
+typedef BatchedLcdI2C BenchmarkLcd;
+#else
+#include <LiquidCrystal_I2C.h>
+typedef LiquidCrystal_I2C BenchmarkLcd;
+#endif
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+/**
+ * Display that counts the bytes sent to it
+ */
+class CountingLcd {
+   public:
+    BenchmarkLcd lcd;
+    uint32_t bytes = 0;
+
+    CountingLcd(uint8_t address, uint8_t cols, uint8_t rows)
+        : lcd(address, cols, rows) {}
+
+    size_t write(uint8_t value) {
+        bytes++;
+        return lcd.write(value);
+    }
+    void setCursor(uint8_t col, uint8_t row) {
+        bytes++;
+        lcd.setCursor(col, row);
+    }
+    void clear() {
+        bytes++;
+        lcd.clear();
+    }
+    void createChar(uint8_t location, uint8_t charmap[]) {
+        bytes += 9;
+        lcd.createChar(location, charmap);
+    }
+    void blink() {
+        bytes++;
+        lcd.blink();
+    }
+    void noBlink() {
+        bytes++;
+        lcd.noBlink();
+    }
+    void display() {
+        bytes++;
+        lcd.display();
+    }
+    void noDisplay() {
+        bytes++;
+        lcd.noDisplay();
+    }
+    void setBacklight(uint8_t state) { lcd.setBacklight(state); }
+    void noBacklight() { lcd.noBacklight(); }
+    void flush() { lcd.flush(); }
+};
+
+#if defined(__AVR__)
+volatile uint16_t timerOverflows = 0;
+
+ISR(TIMER1_OVF_vect) { timerOverflows++; }
+
+void startCycleCounter() {
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);  // no prescaler, one tick per cycle
+    TCNT1 = 0;
+    TIMSK1 = _BV(TOIE1);
+}
+
+uint32_t cycles() {
+    uint8_t sreg = SREG;
+    cli();
+    uint16_t low = TCNT1;
+    uint16_t high = timerOverflows;
+    // overflow not handled yet
+    if ((TIFR1 & _BV(TOV1)) && low < 0x8000) high++;
+    SREG = sreg;
+    return ((uint32_t)high << 16) | low;
+}
+#else
+void startCycleCounter() {}
+
+uint32_t cycles() { return micros() * clockCyclesPerMicrosecond(); }
+#endif
+
+// Declare the callbacks
+void inputCallback(char* value) {}
+void progressCallback(uint16_t value) {}
+void toggleCallback(uint16_t isOn) {}
+
+char name[9] = "";
+
+extern MenuItem* settingsMenu[];
+
+// Initialize the main menu items
+MAIN_MENU(
+    ITEM_BASIC("Start service"),
+    ITEM_SUBMENU("Settings", settingsMenu),
+    ITEM_INPUT("Name", name, sizeof(name), inputCallback),
+    ITEM_PROGRESS("Volume", 10, progressCallback),
+    ITEM_TOGGLE("Backlight", toggleCallback),
+    ITEM_BASIC("Connect to WiFi"),
+    ITEM_BASIC("Blink SOS"),
+    ITEM_BASIC("Blink random"),
+    ITEM_BASIC("Restart")
+);
+// Initialize the sub menu items
+SUB_MENU(settingsMenu, mainMenu,
+    ITEM_BASIC("Contrast"),
+    ITEM_BASIC("Brightness"),
+    ITEM_BASIC("Language"),
+    ITEM_BASIC("About")
+);
+
+CountingLcd display(0x27, LCD_COLS, LCD_ROWS);
+GenericLcdMenu<CountingLcd> menu(LCD_ROWS, LCD_COLS);
+
+/**
+ * Cost of the calls of one step of the benchmark
+ */
+struct Measure {
+    uint16_t calls;
+    uint32_t cycles;
+    uint32_t maxCycles;
+    uint32_t bytes;
+};
+
+Measure measure;
+Measure total;
+
+// Time one call and add it to the current step
+#define MEASURE(call)                                  \
+    do {                                               \
+        uint32_t bytesBefore = display.bytes;          \
+        uint32_t start = cycles();                     \
+        call;                                          \
+        uint32_t elapsed = cycles() - start;           \
+        measure.calls++;                               \
+        measure.cycles += elapsed;                     \
+        if (elapsed > measure.maxCycles) {             \
+            measure.maxCycles = elapsed;               \
+        }                                              \
+        measure.bytes += display.bytes - bytesBefore;  \
+    } while (0)
+
+void beginStep() { memset(&measure, 0, sizeof(measure)); }
+
+void printField(const __FlashStringHelper* name, uint32_t value) {
+    Serial.print(F(",\""));
+    Serial.print(name);
+    Serial.print(F("\":"));
+    Serial.print(value);
+}
+
+void report(const __FlashStringHelper* name, const Measure& m) {
+    Serial.print(F("{\"benchmark\":\""));
+    Serial.print(name);
+    Serial.print('"');
+    printField(F("calls"), m.calls);
+    printField(F("cycles"), m.cycles);
+    printField(F("max_cycles"), m.maxCycles);
+    printField(F("us"), m.cycles / clockCyclesPerMicrosecond());
+    printField(F("max_us"), m.maxCycles / clockCyclesPerMicrosecond());
+    printField(F("bytes"), m.bytes);
+    Serial.println('}');
+}
+
+void endStep(const __FlashStringHelper* name) {
+    report(name, measure);
+    total.calls += measure.calls;
+    total.cycles += measure.cycles;
+    total.maxCycles = max(total.maxCycles, measure.maxCycles);
+    total.bytes += measure.bytes;
+}
+
+void setup() {
+    Serial.begin(115200);
+    startCycleCounter();
+    display.lcd.init();
+    display.lcd.backlight();
+    menu.setupLcdWithMenu(display, mainMenu);
+
+    // Whole screen sent again
+    beginStep();
+    for (uint8_t i = 0; i < 5; i++) {
+        menu.hide();
+        MEASURE(menu.show());
+    }
+    endStep(F("repaint"));
+
+    // Menu drawn again, nothing changed on the display
+    beginStep();
+    for (uint8_t i = 0; i < 10; i++) MEASURE(menu.update());
+    endStep(F("update"));
+
+    // Only the cursor moves
+    beginStep();
+    for (uint8_t i = 0; i < 5; i++) {
+        MEASURE(menu.down());
+        MEASURE(menu.up());
+    }
+    endStep(F("cursor"));
+
+    // Scroll to the end of the menu and back
+    beginStep();
+    for (uint8_t i = 0; i < 9; i++) MEASURE(menu.down());
+    for (uint8_t i = 0; i < 9; i++) MEASURE(menu.up());
+    endStep(F("scroll"));
+
+    // Enter and leave the sub menu
+    beginStep();
+    menu.down();
+    for (uint8_t i = 0; i < 5; i++) {
+        MEASURE(menu.enter());
+        MEASURE(menu.down());
+        MEASURE(menu.back());
+    }
+    endStep(F("submenu"));
+
+    // Edit the input
+    beginStep();
+    menu.down();
+    MEASURE(menu.enter());
+    for (uint8_t i = 0; i < 4; i++) {
+        MEASURE(menu.drawChar('A' + i));
+        MEASURE(menu.type('A' + i));
+    }
+    MEASURE(menu.left());
+    MEASURE(menu.insert('Z'));
+    MEASURE(menu.right());
+    MEASURE(menu.backspace());
+    MEASURE(menu.back());
+    endStep(F("input"));
+
+    // Sweep the progress
+    beginStep();
+    menu.down();
+    MEASURE(menu.enter());
+    for (uint8_t i = 0; i < 20; i++) MEASURE(menu.right());
+    for (uint8_t i = 0; i < 20; i++) MEASURE(menu.left());
+    MEASURE(menu.back());
+    endStep(F("progress"));
+
+    // Move the progress by many steps at once
+    beginStep();
+    MEASURE(menu.enter());
+    for (uint8_t i = 0; i < 10; i++) MEASURE(menu.adjust(i & 1 ? -50 : 50));
+    MEASURE(menu.back());
+    endStep(F("adjust"));
+
+    report(F("total"), total);
+    Serial.println(F("{\"done\":true}"));
+}
+
+void loop() {}
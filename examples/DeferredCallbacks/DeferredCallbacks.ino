@@ -0,0 +1,71 @@
+/*
+ Deferred Callbacks
+
+ The change callbacks save the settings, e.g. to the EEPROM. They are
+ called by poll() once the value hasn't changed for a second instead of on
+ each step, the values in between are dropped.
+
+*/
+#include <ItemList.h>
+#include <ItemProgress.h>
+#include <LcdMenu.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// Configure keyboard keys (ASCII)
+#define UP 56     // NUMPAD 8
+#define DOWN 50   // NUMPAD 2
+#define LEFT 52   // NUMPAD 4
+#define RIGHT 54  // NUMPAD 6
+#define ENTER 53  // NUMPAD 5
+#define BACK 55   // NUMPAD 7
+
+void saveBrightness(uint16_t value);
+void saveMode(uint16_t index);
+void selected(uint16_t value) {}
+
+const char* modes[] = {"Auto", "Eco", "Boost"};
+
+MAIN_MENU(
+    ITEM_PROGRESS("Brightness", 500, 10, NULL, saveBrightness, selected),
+    ITEM_STRING_LIST("Mode", modes, 3, saveMode, selected)
+);
+
+LcdMenu menu(LCD_ROWS, LCD_COLS);
+
+void setup() {
+    Serial.begin(9600);
+    menu.setupLcdWithMenu(0x27, mainMenu);
+    // Wait for the values to settle for 1s before saving them
+    menu.setChangeInterval(1000, true);
+}
+
+void loop() {
+    menu.poll();
+    if (!Serial.available()) return;
+    char command = Serial.read();
+
+    if (command == UP)
+        menu.up();
+    else if (command == DOWN)
+        menu.down();
+    else if (command == LEFT)
+        menu.left();
+    else if (command == RIGHT)
+        menu.right();
+    else if (command == ENTER)
+        menu.enter();
+    else if (command == BACK)
+        menu.back();
+}
+
+void saveBrightness(uint16_t value) {
+    Serial.print(F("Saving brightness "));
+    Serial.println(value);
+}
+
+void saveMode(uint16_t index) {
+    Serial.print(F("Saving mode "));
+    Serial.println(modes[index]);
+}
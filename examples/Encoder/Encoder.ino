@@ -0,0 +1,57 @@
+/*
+ Rotary Encoder
+
+ The encoder is read in an interrupt that only queues the events, the menu
+ handles them in loop() and is drawn once for each burst of detents.
+
+*/
+
+#include <LcdMenu.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// Configure the encoder pins, CLK must support interrupts
+#define ENCODER_CLK 2
+#define ENCODER_DT 3
+#define ENCODER_SW 4
+
+// Initialize the main menu items
+MAIN_MENU(
+    ITEM_BASIC("Start service"),
+    ITEM_BASIC("Connect to WiFi"),
+    ITEM_BASIC("Settings"),
+    ITEM_BASIC("Blink SOS"),
+    ITEM_BASIC("Blink random"),
+    ITEM_BASIC("Restart"),
+    ITEM_BASIC("About")
+);
+// Construct the LcdMenu
+LcdMenu menu(LCD_ROWS, LCD_COLS);
+
+void onEncoderTurned() {
+    if (digitalRead(ENCODER_DT))
+        menu.pushEvent(MENU_EVENT_DOWN);
+    else
+        menu.pushEvent(MENU_EVENT_UP);
+}
+
+void setup() {
+    pinMode(ENCODER_CLK, INPUT_PULLUP);
+    pinMode(ENCODER_DT, INPUT_PULLUP);
+    pinMode(ENCODER_SW, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(ENCODER_CLK), onEncoderTurned,
+                    FALLING);
+    // Initialize LcdMenu with the menu items
+    menu.setupLcdWithMenu(0x27, mainMenu);
+}
+
+void loop() {
+    static bool wasPressed = false;
+    bool isPressed = !digitalRead(ENCODER_SW);
+    if (isPressed && !wasPressed)
+        menu.pushEvent(MENU_EVENT_ENTER);
+    wasPressed = isPressed;
+    // Execute the queued events and draw the menu
+    menu.poll();
+}
@@ -0,0 +1,78 @@
+/*
+ Flash Menu
+
+ Menu items are statically allocated and their texts are stored in flash
+ memory, no heap is used and the texts do not take any RAM.
+
+*/
+
+#include <ItemCommand.h>
+#include <ItemToggle.h>
+#include <LcdMenu.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// Configure keyboard keys (ASCII)
+#define UP 56        // NUMPAD 8
+#define DOWN 50      // NUMPAD 2
+#define LEFT 52      // NUMPAD 4
+#define RIGHT 54     // NUMPAD 6
+#define ENTER 53     // NUMPAD 5
+#define BACK 55      // NUMPAD 7
+#define BACKSPACE 8  // BACKSPACE
+#define CLEAR 46     // NUMPAD .
+
+// Declare the callbacks
+void startService();
+void toggleBacklight(uint16_t isOn);
+
+// Texts of the items, stored in flash memory
+const char startText[] PROGMEM = "Start service";
+const char wifiText[] PROGMEM = "Connect to WiFi";
+const char backlightText[] PROGMEM = "Backlight";
+const char sosText[] PROGMEM = "Blink SOS";
+
+// Statically allocated items
+ItemCommand start(FLASH_TEXT(startText), startService);
+MenuItem wifi(FLASH_TEXT(wifiText));
+ItemToggle backlight(FLASH_TEXT(backlightText), toggleBacklight);
+MenuItem sos(FLASH_TEXT(sosText));
+
+// Initialize the main menu items
+MAIN_MENU(&start, &wifi, &backlight, &sos);
+
+// Construct the LcdMenu
+LcdMenu menu(LCD_ROWS, LCD_COLS);
+
+void setup() {
+    Serial.begin(9600);
+    // Initialize LcdMenu with the menu items
+    menu.setupLcdWithMenu(0x27, mainMenu);
+}
+
+void loop() {
+    if (!Serial.available()) return;
+    char command = Serial.read();
+
+    if (command == UP)
+        menu.up();
+    else if (command == DOWN)
+        menu.down();
+    else if (command == LEFT)
+        menu.left();
+    else if (command == RIGHT)
+        menu.right();
+    else if (command == ENTER)
+        menu.enter();
+    else if (command == BACK)
+        menu.back();
+}
+
+void startService() {
+    Serial.println(F("Service started"));
+}
+
+void toggleBacklight(uint16_t isOn) {
+    menu.setBacklight(isOn);
+}
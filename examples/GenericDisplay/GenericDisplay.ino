@@ -0,0 +1,64 @@
+/*
+ Generic Display
+
+ The display is created by the sketch and given to the menu, nothing is
+ allocated on the heap. Any class with the methods of LiquidCrystal_I2C
+ used by the menu can be given to GenericLcdMenu.
+
+*/
+
+#include <GenericLcdMenu.h>
+#include <LiquidCrystal_I2C.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// Configure keyboard keys (ASCII)
+#define UP 56        // NUMPAD 8
+#define DOWN 50      // NUMPAD 2
+#define LEFT 52      // NUMPAD 4
+#define RIGHT 54     // NUMPAD 6
+#define ENTER 53     // NUMPAD 5
+#define BACK 55      // NUMPAD 7
+#define BACKSPACE 8  // BACKSPACE
+#define CLEAR 46     // NUMPAD .
+
+// Initialize the main menu items
+MAIN_MENU(
+    ITEM_BASIC("Start service"),
+    ITEM_BASIC("Connect to WiFi"),
+    ITEM_BASIC("Settings"),
+    ITEM_BASIC("Blink SOS"),
+    ITEM_BASIC("Blink random")
+);
+// Construct the display
+LiquidCrystal_I2C lcd(0x27, LCD_COLS, LCD_ROWS);
+// Construct the menu for this type of display
+GenericLcdMenu<LiquidCrystal_I2C> menu(LCD_ROWS, LCD_COLS);
+
+void setup() {
+    Serial.begin(9600);
+    // Initialize the display
+    lcd.init();
+    lcd.backlight();
+    // Show the menu items on the display
+    menu.setupLcdWithMenu(lcd, mainMenu);
+}
+
+void loop() {
+    if (!Serial.available()) return;
+    char command = Serial.read();
+
+    if (command == UP)
+        menu.up();
+    else if (command == DOWN)
+        menu.down();
+    else if (command == LEFT)
+        menu.left();
+    else if (command == RIGHT)
+        menu.right();
+    else if (command == ENTER)
+        menu.enter();
+    else if (command == BACK)
+        menu.back();
+}
@@ -25,24 +25,23 @@
 void colorsCallback(uint16_t pos);
 void numsCallback(uint16_t pos);
 
-// Declare the array
-extern String colors[];
 // Initialize the array
-String colors[] = {"Red",  "Green",  "Blue",   "Orange",
-                   "Aqua", "Yellow", "Purple", "Pink"};
+const char *colors[] = {"Red",  "Green",  "Blue",   "Orange",
+                        "Aqua", "Yellow", "Purple", "Pink"};
 
-// Declare the array
-extern String nums[];
-// Initialize the array
-String nums[] = {
-    "5", "7", "9", "12", "32",
-};
+// Initialize the array in flash memory
+const char num0[] PROGMEM = "5";
+const char num1[] PROGMEM = "7";
+const char num2[] PROGMEM = "9";
+const char num3[] PROGMEM = "12";
+const char num4[] PROGMEM = "32";
+const char *const nums[] PROGMEM = {num0, num1, num2, num3, num4};
 
 // Initialize the main menu items
 MAIN_MENU(
     ITEM_BASIC("List demo"),
-    ITEM_STRING_LIST("Col", colors, 9, colorsCallback),
-    ITEM_STRING_LIST("Num", nums, 5, numsCallback),
+    ITEM_STRING_LIST("Col", colors, 8, colorsCallback),
+    ITEM_STRING_LIST("Num", FLASH_TEXT_LIST(nums), 5, numsCallback),
     ITEM_BASIC("Example")
 );
 
@@ -81,5 +80,5 @@ void colorsCallback(uint16_t pos) {
 
 void numsCallback(uint16_t pos) {
     // do something with the index
-    Serial.println(nums[pos]);
+    Serial.println((const __FlashStringHelper *)pgm_read_ptr(&nums[pos]));
 }
@@ -0,0 +1,71 @@
+/*
+ Live Values
+
+ Readings of sensors shown in the menu, each value is read at most once per
+ interval while it is on the display and only the characters that changed
+ are sent.
+
+*/
+
+#include <ItemLive.h>
+#include <LcdMenu.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// Configure keyboard keys (ASCII)
+#define UP 56        // NUMPAD 8
+#define DOWN 50      // NUMPAD 2
+#define ENTER 53     // NUMPAD 5
+#define BACK 55      // NUMPAD 7
+
+// Declare the providers of the values
+char* readLight();
+char* readUptime();
+
+// Initialize the main menu items
+MAIN_MENU(
+    ITEM_LIVE("Light", readLight, 200),
+    ITEM_LIVE("Uptime", readUptime, 1000),
+    ITEM_BASIC("Settings"),
+    ITEM_BASIC("About")
+);
+// Construct the LcdMenu
+LcdMenu menu(LCD_ROWS, LCD_COLS);
+
+void setup() {
+    Serial.begin(9600);
+    // Initialize LcdMenu with the menu items
+    menu.setupLcdWithMenu(0x27, mainMenu);
+}
+
+void loop() {
+    // Refresh the values on the display
+    menu.poll();
+
+    if (!Serial.available()) return;
+    char command = Serial.read();
+
+    if (command == UP)
+        menu.up();
+    else if (command == DOWN)
+        menu.down();
+    else if (command == ENTER)
+        menu.enter();
+    else if (command == BACK)
+        menu.back();
+}
+/**
+ * Define the providers, they return the text of the value
+ */
+char* readLight() {
+    static char text[6];
+    itoa(analogRead(A0), text, 10);
+    return text;
+}
+char* readUptime() {
+    static char text[11];
+    ultoa(millis() / 1000, text, 10);
+    strcat(text, "s");
+    return text;
+}
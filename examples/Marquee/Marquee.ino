@@ -0,0 +1,53 @@
+/*
+ Marquee
+
+ The label under the cursor scrolls when it is longer than the display,
+ only its line is sent again at each step.
+
+*/
+
+#include <LcdMenu.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// Configure keyboard keys (ASCII)
+#define UP 56     // NUMPAD 8
+#define DOWN 50   // NUMPAD 2
+#define ENTER 53  // NUMPAD 5
+#define BACK 55   // NUMPAD 7
+
+// Initialize the main menu items
+MAIN_MENU(
+    ITEM_BASIC("Start service"),
+    ITEM_BASIC("Connect to the WiFi network"),
+    ITEM_BASIC("Restore the factory settings"),
+    ITEM_BASIC("About")
+);
+// Construct the LcdMenu
+LcdMenu menu(LCD_ROWS, LCD_COLS);
+
+void setup() {
+    Serial.begin(9600);
+    // Initialize LcdMenu with the menu items
+    menu.setupLcdWithMenu(0x27, mainMenu);
+    // Move long labels by one character every 400ms
+    menu.setMarquee(400);
+}
+
+void loop() {
+    // Scroll the label under the cursor
+    menu.poll();
+
+    if (!Serial.available()) return;
+    char command = Serial.read();
+
+    if (command == UP)
+        menu.up();
+    else if (command == DOWN)
+        menu.down();
+    else if (command == ENTER)
+        menu.enter();
+    else if (command == BACK)
+        menu.back();
+}
@@ -33,6 +33,8 @@ LcdMenu menu(LCD_ROWS, LCD_COLS);
 void setup() {
     Serial.begin(9600);
     menu.setupLcdWithMenu(0x27, mainMenu, 20000);
+    // Switch the backlight off after 10s, the text stays visible until 20s
+    menu.setDimTimeout(10000);
 }
 
 void loop() {
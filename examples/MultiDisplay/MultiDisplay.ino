@@ -0,0 +1,70 @@
+/*
+ Multiple Displays
+
+ A 20x4 display shows the menu and a 16x2 display on the same I2C bus shows
+ the status, both are sent a few characters at a time within one time
+ budget so that loop() never waits for either of them.
+
+*/
+
+#include <LcdMenu.h>
+#include <ItemLive.h>
+#include <MenuScheduler.h>
+
+// Configure keyboard keys (ASCII)
+#define UP 56     // NUMPAD 8
+#define DOWN 50   // NUMPAD 2
+#define ENTER 53  // NUMPAD 5
+#define BACK 55   // NUMPAD 7
+
+char *uptime() {
+    static char text[11];
+    ultoa(millis() / 1000, text, 10);
+    return text;
+}
+
+// Initialize the main menu items
+MAIN_MENU(
+    ITEM_BASIC("Start service"),
+    ITEM_BASIC("Connect to WiFi"),
+    ITEM_BASIC("Settings")
+);
+// The status display has a menu of its own
+extern MenuItem* statusMenu[];
+MenuItem* statusMenu[] = {new ItemHeader(),
+                          ITEM_LIVE("Uptime", uptime, 1000),
+                          new ItemFooter()};
+// Construct one LcdMenu per display
+LcdMenu menu(4, 20);
+LcdMenu status(2, 16);
+// At most 1ms per call to poll() for both displays
+MenuScheduler scheduler(1000);
+
+void setup() {
+    Serial.begin(9600);
+    // Render in slices, the scheduler gives them its time budget
+    menu.setRenderBudget(4);
+    status.setRenderBudget(4);
+    // Initialize each LcdMenu with its address and menu items
+    menu.setupLcdWithMenu(0x27, mainMenu);
+    status.setupLcdWithMenu(0x26, statusMenu);
+    scheduler.add(menu);
+    scheduler.add(status);
+}
+
+void loop() {
+    // Send the next slice of both displays
+    scheduler.poll();
+
+    if (!Serial.available()) return;
+    char command = Serial.read();
+
+    if (command == UP)
+        menu.up();
+    else if (command == DOWN)
+        menu.down();
+    else if (command == ENTER)
+        menu.enter();
+    else if (command == BACK)
+        menu.back();
+}
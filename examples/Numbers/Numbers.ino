@@ -0,0 +1,78 @@
+/*
+ Fixed Point Numbers
+
+ Same values as the IntFloatValues example without mapping the progress,
+ the numbers are stored in fixed point and formatted with integer math.
+
+*/
+
+#include <ItemNumber.h>
+#include <LcdMenu.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// Configure keyboard keys (ASCII)
+#define UP 56     // NUMPAD 8
+#define DOWN 50   // NUMPAD 2
+#define LEFT 52   // NUMPAD 4
+#define RIGHT 54  // NUMPAD 6
+#define ENTER 53  // NUMPAD 5
+#define BACK 55   // NUMPAD 7
+
+// Declare the callbacks
+void distanceCallback(uint16_t value);
+void currentCallback(uint16_t value);
+
+// 100 to 200 meters by steps of 1
+ItemNumber<uint8_t, 100, 200> distance("Dist(m)", 110, distanceCallback);
+// -1.00 to 1.00 amps by steps of 0.05, stored in hundredths
+ItemNumber<int16_t, -100, 100, 5, 2> current("Curr(A)", 0, currentCallback);
+
+// Initialize the main menu items
+MAIN_MENU(
+    ITEM_BASIC("Con"),
+    &distance,
+    &current,
+    ITEM_BASIC("Blink SOS"),
+    ITEM_BASIC("Blink random")
+);
+
+// Construct the LcdMenu
+LcdMenu menu(LCD_ROWS, LCD_COLS);
+
+void setup() {
+    Serial.begin(9600);
+    // Initialize LcdMenu with the menu items
+    menu.setupLcdWithMenu(0x27, mainMenu);
+}
+
+void loop() {
+    if (!Serial.available()) return;
+    char command = Serial.read();
+
+    if (command == UP)
+        menu.up();
+    else if (command == DOWN)
+        menu.down();
+    else if (command == LEFT)
+        menu.left();
+    else if (command == RIGHT)
+        menu.right();
+    else if (command == ENTER)
+        menu.enter();
+    else if (command == BACK)
+        menu.back();
+}
+
+void distanceCallback(uint16_t value) {
+    Serial.print(F("Distance: "));
+    Serial.println(value);
+}
+
+void currentCallback(uint16_t value) {
+    // Cast the value back to the type of the item, it is in hundredths
+    int16_t hundredths = value;
+    Serial.print(F("Current (cA): "));
+    Serial.println(hundredths);
+}
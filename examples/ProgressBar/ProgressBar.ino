@@ -0,0 +1,62 @@
+/*
+ Progress Bar
+
+ The volume is drawn as a bar of 8 characters made of custom characters,
+ each step of the progress fills one more column of a character so only
+ one or two characters are sent to the display.
+
+*/
+#include <ItemProgress.h>
+#include <LcdMenu.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// Configure keyboard keys (ASCII)
+#define UP 56     // NUMPAD 8
+#define DOWN 50   // NUMPAD 2
+#define LEFT 52   // NUMPAD 4
+#define RIGHT 54  // NUMPAD 6
+#define ENTER 53  // NUMPAD 5
+#define BACK 55   // NUMPAD 7
+
+void volumeCallback(uint16_t value);
+
+// 40 columns in 8 characters, one column per step of 25
+ItemProgress volume("Volume", 500, 25, NULL, volumeCallback);
+
+MAIN_MENU(
+    &volume,
+    ITEM_BASIC("About")
+);
+
+LcdMenu menu(LCD_ROWS, LCD_COLS);
+
+void setup() {
+    Serial.begin(9600);
+    volume.setBarCells(8);
+    menu.setupLcdWithMenu(0x27, mainMenu);
+}
+
+void loop() {
+    if (!Serial.available()) return;
+    char command = Serial.read();
+
+    if (command == UP)
+        menu.up();
+    else if (command == DOWN)
+        menu.down();
+    else if (command == LEFT)
+        menu.left();
+    else if (command == RIGHT)
+        menu.right();
+    else if (command == ENTER)
+        menu.enter();
+    else if (command == BACK)
+        menu.back();
+}
+
+void volumeCallback(uint16_t value) {
+    Serial.print(F("# "));
+    Serial.println(value);
+}
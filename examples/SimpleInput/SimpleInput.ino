@@ -58,8 +58,10 @@ void loop() {
         menu.clear();
     else if (command == BACKSPACE)  // Remove one character from tail
         menu.backspace();
-    else  // Type the character you want
+    else if (menu.isInEditMode())  // Type the character you want
         menu.type(command);
+    else  // Jump to the next item starting with the character
+        menu.jumpTo(command);
 }
 /**
  * Define callback
@@ -0,0 +1,90 @@
+/*
+ Menu Stats
+
+ Counts what the menu does to find out whether a lag comes from drawing the
+ menu or from the callbacks, the counters are printed every 5 seconds.
+
+*/
+
+// Enable the counters, must be defined before including the menu
+#define ENABLE_MENU_STATS
+#include <ItemCommand.h>
+#include <LcdMenu.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// Configure keyboard keys (ASCII)
+#define UP 56        // NUMPAD 8
+#define DOWN 50      // NUMPAD 2
+#define LEFT 52      // NUMPAD 4
+#define RIGHT 54     // NUMPAD 6
+#define ENTER 53     // NUMPAD 5
+#define BACK 55      // NUMPAD 7
+#define BACKSPACE 8  // BACKSPACE
+#define CLEAR 46     // NUMPAD .
+
+// Declare the callbacks
+void slowCallback();
+
+// Initialize the main menu items
+MAIN_MENU(
+    ITEM_BASIC("Start service"),
+    ITEM_COMMAND("Slow command", slowCallback),
+    ITEM_BASIC("Settings"),
+    ITEM_BASIC("Blink SOS"),
+    ITEM_BASIC("Blink random")
+);
+// Construct the LcdMenu
+LcdMenu menu(LCD_ROWS, LCD_COLS);
+
+unsigned long lastReport = 0;
+
+void setup() {
+    Serial.begin(9600);
+    // Initialize LcdMenu with the menu items
+    menu.setupLcdWithMenu(0x27, mainMenu);
+}
+
+void printStat(const __FlashStringHelper* name, uint32_t value) {
+    Serial.print(name);
+    Serial.print(F(": "));
+    Serial.println(value);
+}
+
+void loop() {
+    if (millis() - lastReport >= 5000) {
+        lastReport = millis();
+        const MenuStats& stats = menu.getStats();
+        printStat(F("updates"), stats.updates);
+        printStat(F("menu draws"), stats.menuDraws);
+        printStat(F("items scanned"), stats.itemsScanned);
+        printStat(F("characters written"), stats.charsWritten);
+        printStat(F("render us"), stats.renderMicros);
+        printStat(F("callback us"), stats.callbackMicros);
+        printStat(F("slowest callback us"), stats.maxCallbackMicros);
+        menu.resetStats();
+    }
+
+    if (!Serial.available()) return;
+    char command = Serial.read();
+
+    if (command == UP)
+        menu.up();
+    else if (command == DOWN)
+        menu.down();
+    else if (command == LEFT)
+        menu.left();
+    else if (command == RIGHT)
+        menu.right();
+    else if (command == ENTER)
+        menu.enter();
+    else if (command == BACK)
+        menu.back();
+}
+
+// Define the callbacks
+void slowCallback() {
+    // Simulate a callback that blocks the menu
+    delay(200);
+}
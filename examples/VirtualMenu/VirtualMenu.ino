@@ -0,0 +1,64 @@
+/*
+ Virtual Menu
+
+ A menu of 1000 sensors, only the entries on the display are kept in
+ memory and their text is generated when they are drawn.
+
+*/
+#include <ItemSubMenu.h>
+#include <VirtualMenu.h>
+#include <LcdMenu.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// Configure keyboard keys (ASCII)
+#define UP 56     // NUMPAD 8
+#define DOWN 50   // NUMPAD 2
+#define ENTER 53  // NUMPAD 5
+#define BACK 55   // NUMPAD 7
+
+#define SENSOR_COUNT 1000
+
+// Text of the sensor at an index, it is copied before the next call
+char* sensorName(uint16_t index) {
+    static char name[12];
+    sprintf(name, "Sensor %u", index);
+    return name;
+}
+
+void selectSensor(uint16_t index) {
+    Serial.print(F("Selected sensor "));
+    Serial.println(index);
+}
+
+extern MenuItem* mainMenu[];
+
+VirtualMenu sensors(mainMenu, SENSOR_COUNT, sensorName, selectSensor);
+
+// Define the main menu
+MAIN_MENU(
+    ITEM_SUBMENU("Sensors", sensors.getMenu()),
+    ITEM_BASIC("About")
+);
+
+LcdMenu menu(LCD_ROWS, LCD_COLS);
+
+void setup() {
+    Serial.begin(9600);
+    menu.setupLcdWithMenu(0x27, mainMenu);
+}
+
+void loop() {
+    if (!Serial.available()) return;
+    char command = Serial.read();
+
+    if (command == UP)
+        menu.up();
+    else if (command == DOWN)
+        menu.down();
+    else if (command == ENTER)
+        menu.enter();
+    else if (command == BACK)
+        menu.back();
+}
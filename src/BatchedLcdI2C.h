@@ -0,0 +1,233 @@
+/**
+ * ---
+ *
+ * # BatchedLcdI2C
+ *
+ * Driver for HD44780 displays behind a PCF8574 I2C backpack that sends the
+ * characters in as few I2C transmissions as possible.
+ *
+ * Each nibble sent to the display takes two bytes on the bus (enable high
+ * then low). When switching between commands and characters a byte with
+ * enable low is sent first so RS is stable before enable rises, as
+ * `LiquidCrystal_I2C` does. The bytes are queued and sent in a single
+ * transmission when the queue is full or when `flush()` is called. The menu
+ * calls `flush()` after sending its changes, call it after printing anything
+ * else.
+ *
+ * The timing of the display relies on the speed of the bus, it must not be
+ * faster than 400kHz.
+ */
+
+#ifndef BatchedLcdI2C_H
+#define BatchedLcdI2C_H
+#include <Arduino.h>
+#include <Wire.h>
+
+/**
+ * Bytes sent per I2C transmission, at most the size of the buffer of `Wire`
+ * (32 bytes on AVR). The default fits 7 characters.
+ */
+#ifndef LCD_I2C_BATCH_SIZE
+#define LCD_I2C_BATCH_SIZE 28
+#endif
+
+class BatchedLcdI2C final : public Print {
+   private:
+    //
+    // PCF8574 pins
+    //
+    static const uint8_t RS = 0x01;
+    static const uint8_t EN = 0x04;
+    static const uint8_t BACKLIGHT = 0x08;
+    //
+    // HD44780 commands
+    //
+    static const uint8_t LCD_CLEARDISPLAY = 0x01;
+    static const uint8_t LCD_RETURNHOME = 0x02;
+    static const uint8_t LCD_ENTRYMODESET = 0x04;
+    static const uint8_t LCD_DISPLAYCONTROL = 0x08;
+    static const uint8_t LCD_FUNCTIONSET = 0x20;
+    static const uint8_t LCD_SETCGRAMADDR = 0x40;
+    static const uint8_t LCD_SETDDRAMADDR = 0x80;
+    static const uint8_t LCD_DISPLAYON = 0x04;
+    static const uint8_t LCD_CURSORON = 0x02;
+    static const uint8_t LCD_BLINKON = 0x01;
+
+    uint8_t address;
+    uint8_t cols;
+    uint8_t rows;
+    uint8_t backlightBit = BACKLIGHT;
+    uint8_t displayControl = LCD_DISPLAYON;
+    uint8_t batch[LCD_I2C_BATCH_SIZE];
+    uint8_t batchLength = 0;
+    /**
+     * RS pin of the last byte sent to the PCF8574
+     */
+    uint8_t lastMode = 0;
+
+    /**
+     * Queue the bytes that latch a nibble in the display, RS is set with
+     * enable low first when it changes (address set-up time of the HD44780)
+     * @param nibble value in the 4 high bits
+     * @param mode `RS` for data, 0 for a command
+     */
+    void queueNibble(uint8_t nibble, uint8_t mode) {
+        bool isModeChanged = mode != lastMode;
+        if (batchLength + 2 + isModeChanged > LCD_I2C_BATCH_SIZE) flush();
+        uint8_t value = nibble | mode | backlightBit;
+        if (isModeChanged) {
+            batch[batchLength++] = value;
+            lastMode = mode;
+        }
+        batch[batchLength++] = value | EN;
+        batch[batchLength++] = value;
+    }
+    /**
+     * Queue a byte for the display
+     * @param value byte to send
+     * @param mode `RS` for data, 0 for a command
+     */
+    void queue(uint8_t value, uint8_t mode) {
+        queueNibble(value & 0xF0, mode);
+        queueNibble(value << 4, mode);
+    }
+    /**
+     * Send a command right away
+     * @param value command to send
+     */
+    void command(uint8_t value) {
+        queue(value, 0);
+        flush();
+    }
+    /**
+     * Send a byte to the PCF8574 without latching it in the display
+     * @param value byte to send
+     */
+    void expanderWrite(uint8_t value) {
+        Wire.beginTransmission(address);
+        Wire.write(value | backlightBit);
+        Wire.endTransmission();
+        lastMode = value & RS;
+    }
+
+   public:
+    /**
+     * @param address address of the PCF8574 on the I2C bus e.g. 0x27
+     * @param cols columns on the display
+     * @param rows rows on the display
+     */
+    BatchedLcdI2C(uint8_t address, uint8_t cols, uint8_t rows)
+        : address(address), cols(cols), rows(rows) {}
+
+    /**
+     * Initialize the bus and the display
+     * @param clock frequency of the I2C bus, at most 400kHz
+     */
+    void begin(uint32_t clock = 400000) {
+        Wire.begin();
+        Wire.setClock(clock);
+        //
+        // wait for the display to power up then switch it to 4 bit mode
+        //
+        delay(50);
+        expanderWrite(0);
+        delay(1000);
+        for (uint8_t i = 0; i < 3; i++) {
+            queueNibble(0x30, 0);
+            flush();
+            delayMicroseconds(4500);
+        }
+        queueNibble(0x20, 0);
+        flush();
+        command(LCD_FUNCTIONSET | (rows > 1 ? 0x08 : 0x00));
+        command(LCD_DISPLAYCONTROL | displayControl);
+        clear();
+        command(LCD_ENTRYMODESET | 0x02);
+    }
+    /**
+     * Same as `begin()`, for compatibility with `LiquidCrystal_I2C`
+     */
+    void init() { begin(); }
+    /**
+     * Send the queued bytes to the display
+     */
+    void flush() {
+        if (!batchLength) return;
+        Wire.beginTransmission(address);
+        Wire.write(batch, batchLength);
+        Wire.endTransmission();
+        batchLength = 0;
+    }
+    /**
+     * Queue a character, it is shown after `flush()`
+     * @param value character to draw
+     * @return `size_t` - 1
+     */
+    size_t write(uint8_t value) override {
+        queue(value, RS);
+        return 1;
+    }
+    /**
+     * Queue a move of the cursor, it is done after `flush()`
+     * @param col column
+     * @param row row
+     */
+    void setCursor(uint8_t col, uint8_t row) {
+        static const uint8_t rowOffsets[] = {0x00, 0x40, 0x14, 0x54};
+        if (row >= rows) row = rows - 1;
+        queue(LCD_SETDDRAMADDR | (col + rowOffsets[row & 3]), 0);
+    }
+    void clear() {
+        command(LCD_CLEARDISPLAY);
+        delayMicroseconds(2000);
+    }
+    void home() {
+        command(LCD_RETURNHOME);
+        delayMicroseconds(2000);
+    }
+    /**
+     * Define a custom character
+     * @param location slot of the character, 0 to 7
+     * @param charmap rows of the character
+     */
+    void createChar(uint8_t location, uint8_t charmap[]) {
+        queue(LCD_SETCGRAMADDR | ((location & 0x7) << 3), 0);
+        for (uint8_t i = 0; i < 8; i++) {
+            queue(charmap[i], RS);
+        }
+        flush();
+    }
+    void display() {
+        displayControl |= LCD_DISPLAYON;
+        command(LCD_DISPLAYCONTROL | displayControl);
+    }
+    void noDisplay() {
+        displayControl &= ~LCD_DISPLAYON;
+        command(LCD_DISPLAYCONTROL | displayControl);
+    }
+    void cursor() {
+        displayControl |= LCD_CURSORON;
+        command(LCD_DISPLAYCONTROL | displayControl);
+    }
+    void noCursor() {
+        displayControl &= ~LCD_CURSORON;
+        command(LCD_DISPLAYCONTROL | displayControl);
+    }
+    void blink() {
+        displayControl |= LCD_BLINKON;
+        command(LCD_DISPLAYCONTROL | displayControl);
+    }
+    void noBlink() {
+        displayControl &= ~LCD_BLINKON;
+        command(LCD_DISPLAYCONTROL | displayControl);
+    }
+    void backlight() { setBacklight(HIGH); }
+    void noBacklight() { setBacklight(LOW); }
+    void setBacklight(uint8_t state) {
+        flush();
+        backlightBit = state ? BACKLIGHT : 0;
+        expanderWrite(0);
+    }
+};
+
+#endif
@@ -1,10 +1,23 @@
 #pragma once
 #include <Arduino.h>
 
+/**
+ * Largest display supported, the screen buffers are allocated with this size
+ * at compile time. Define them before including `LcdMenu.h` to use a larger
+ * display or to save memory on a smaller one.
+ */
+#ifndef LCD_MAX_ROWS
+#define LCD_MAX_ROWS 4
+#endif
+#ifndef LCD_MAX_COLS
+#define LCD_MAX_COLS 20
+#endif
+
 typedef void (*fptr)();
 typedef void (*fptrInt)(uint16_t);
 typedef void (*fptrStr)(char*);
 typedef char* (*fptrMapping)(uint16_t);
+typedef char* (*fptrValue)();
 //
 // menu item types
 //
@@ -18,6 +31,18 @@ const byte MENU_ITEM_TOGGLE = 7;
 const byte MENU_ITEM_END_OF_MENU = 8;
 const byte MENU_ITEM_LIST = 9;
 const byte MENU_ITEM_PROGRESS = 10;
+const byte MENU_ITEM_VIRTUAL_ENTRY = 11;
+const byte MENU_ITEM_LIVE = 12;
+const byte MENU_ITEM_VIRTUAL_MENU = 13;
+//
+// menu events
+//
+const byte MENU_EVENT_UP = 1;
+const byte MENU_EVENT_DOWN = 2;
+const byte MENU_EVENT_LEFT = 3;
+const byte MENU_EVENT_RIGHT = 4;
+const byte MENU_EVENT_ENTER = 5;
+const byte MENU_EVENT_BACK = 6;
 //
 #define MIN_PROGRESS 0
 #define MAX_PROGRESS 1000
\ No newline at end of file
@@ -0,0 +1,3038 @@
+/*
+  GenericLcdMenu.h - Menu drawn on any display driver
+
+  MIT License
+
+  Copyright (c) 2020-2023 Forntoh Thomas
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#pragma once
+
+#include <MenuItem.h>
+#include <utils.h>
+
+/**
+ * Number of sub menus that can be entered one inside the other while keeping
+ * the position in their parents, a deeper menu goes back to its parent given
+ * to `SUB_MENU()` with the cursor on the first item.
+ */
+#ifndef LCD_MENU_MAX_DEPTH
+#define LCD_MENU_MAX_DEPTH 4
+#endif
+/**
+ * Number of items per menu for which the visibility is cached, larger menus
+ * still work but the items past this index are checked one by one.
+ */
+#ifndef MAX_MENU_ITEMS
+#define MAX_MENU_ITEMS 64
+#endif
+/**
+ * Size of the queue of events given to `pushEvent()`, one less event can be
+ * waiting to be processed.
+ */
+#ifndef MENU_EVENT_QUEUE_SIZE
+#define MENU_EVENT_QUEUE_SIZE 16
+#endif
+
+/**
+ * Define `ENABLE_MENU_STATS` before including the menu to count what the
+ * menu does in `MenuStats`, nothing is counted otherwise.
+ */
+#ifdef ENABLE_MENU_STATS
+#define MENU_STAT(statement) statement
+#else
+#define MENU_STAT(statement)
+#endif
+
+#ifdef ENABLE_MENU_STATS
+/**
+ * What the menu did since the stats were last reset, the times are in
+ * microseconds
+ */
+struct MenuStats
+{
+    uint32_t updates = 0;        ///< Calls to `update()`
+    uint32_t menuDraws = 0;      ///< Menus drawn in the buffer
+    uint32_t itemDraws = 0;      ///< Items drawn in the buffer
+    uint32_t rowsReused = 0;     ///< Lines copied from another line
+    uint32_t itemsScanned = 0;   ///< Items checked for visibility
+    uint32_t visibilityRebuilds = 0; ///< Visibility of all items read again
+    uint32_t virtualCalls = 0;   ///< Calls to the virtual item methods
+    uint32_t charsWritten = 0;   ///< Characters sent to the display
+    uint32_t cursorMoves = 0;    ///< Moves of the cursor of the display
+    uint32_t renderMicros = 0;   ///< Time spent drawing and sending
+    uint32_t callbacks = 0;      ///< Calls to the callbacks of the items
+    uint32_t callbackMicros = 0; ///< Time spent in the callbacks
+    uint32_t maxCallbackMicros = 0; ///< Time of the slowest callback
+};
+#endif
+
+/**
+ * The GenericLcdMenu class contains all fields and methods to manipulate the
+ * menu items, it draws them on a display of type `Display`.
+ *
+ * The calls to the display are resolved at compile time, `Display` can be any
+ * class with the methods of the HD44780 libraries used by the menu:
+ *
+ * - `clear()`, `setCursor(col, row)`, `write(uint8_t)`, `flush()` which
+ *   is called after the changes are written, e.g. `Print::flush()`
+ * - `createChar(uint8_t, uint8_t[])`
+ * - `blink()`, `noBlink()`
+ * - `display()`, `noDisplay()`
+ * - `setBacklight(uint8_t)`, `noBacklight()`
+ *
+ * The display is created and initialized by the caller then given to
+ * `setupLcdWithMenu()`, `LcdMenu` can be used for `LiquidCrystal_I2C`
+ * and `LiquidCrystal`.
+ */
+template <class Display> class GenericLcdMenu
+{
+private:
+    /**
+     * ## Private Fields
+     */
+
+    /**
+     * Cursor position
+     */
+    uint8_t cursorPosition = 1;
+    /**
+     * First visible item's position in the menu array
+     */
+    uint8_t top = 1;
+    /**
+     * Edit mode
+     */
+    bool isEditModeEnabled = false;
+    /**
+     * Will prevent left and right movement when in edit mode and character
+     * picker is active
+     */
+    bool isCharPickerActive = false;
+    /**
+     * Last visible item's position in the menu array
+     */
+    uint8_t bottom = 0;
+    /**
+     * Rows on the LCD Display
+     */
+    uint8_t maxRows;
+    /**
+     * Columns on the LCD Display
+     */
+    uint8_t maxCols;
+    /**
+     * Column location of Blinker
+     */
+    uint8_t blinkerPosition = 0;
+#ifdef ItemProgress_H
+    /**
+     * Maximum time between two adjustments of a progress in the same
+     * direction for them to speed up in milliseconds, 0 to disable
+     */
+    uint16_t accelerationInterval = 0;
+    /**
+     * Minimum time between two redraws of a progress in milliseconds
+     */
+    uint16_t progressRefreshInterval = 0;
+    unsigned long lastAdjustTime = 0;
+    unsigned long lastProgressDrawTime = 0;
+    uint8_t adjustRepeats = 0;
+    bool isLastAdjustUp = false;
+    /**
+     * The progress changed but its redraw was postponed
+     */
+    bool isProgressDirty = false;
+#endif
+#if defined(ItemProgress_H) || defined(ItemList_H)
+    /**
+     * Time the change callbacks are deferred for in milliseconds, 0 to call
+     * them on each change
+     */
+    uint16_t changeInterval = 0;
+    /**
+     * Wait for the value to settle instead of calling the change callback
+     * at a fixed rate
+     */
+    bool isChangeNotifiedOnSettle = false;
+    /**
+     * Item whose change callback is waiting to be called
+     */
+    MenuItem *changedItem = NULL;
+    unsigned long firstChangeTime = 0;
+    unsigned long lastChangeTime = 0;
+#endif
+    /**
+     * Characters to be shown on the display, the menu is drawn here then
+     * flushed to the display
+     */
+    uint8_t buffer[LCD_MAX_ROWS][LCD_MAX_COLS];
+    /**
+     * Characters currently shown on the display
+     */
+    uint8_t screen[LCD_MAX_ROWS][LCD_MAX_COLS];
+    /**
+     * Set when the content of the display is unknown, the next flush will
+     * then send every character
+     */
+    bool isScreenInvalid = true;
+    /**
+     * Line of the next character compared by `flush()`
+     */
+    uint8_t flushLine = 0;
+    /**
+     * Column of the next character compared by `flush()`
+     */
+    uint8_t flushCol = 0;
+    /**
+     * Set when the buffer has changes that have not been sent by `poll()`
+     */
+    bool isFrameDirty = false;
+    /**
+     * Set when the blinker must be placed again once the frame is sent
+     */
+    bool isBlinkerDirty = false;
+    /**
+     * Maximum number of characters sent per call to `poll()`, 0 for no limit
+     */
+    uint8_t renderBudget = 0;
+    /**
+     * Maximum time spent sending characters per call to `poll()` in
+     * microseconds, 0 for no limit
+     */
+    uint16_t renderTimeBudget = 0;
+    /**
+     * Events waiting to be processed
+     */
+    volatile byte eventQueue[MENU_EVENT_QUEUE_SIZE];
+    /**
+     * Position where the next event is queued
+     */
+    volatile uint8_t eventHead = 0;
+    /**
+     * Position of the next event to process
+     */
+    volatile uint8_t eventTail = 0;
+    /**
+     * Set while the queued events are processed, the menu is drawn once
+     * they are all done
+     */
+    bool isBatching = false;
+    /**
+     * Set when the menu must be drawn at the end of the batch
+     */
+    bool isRedrawPending = false;
+    /**
+     * Column where the next character is drawn in the buffer
+     */
+    uint8_t bufferCol = 0;
+    /**
+     * Line where the next character is drawn in the buffer
+     */
+    uint8_t bufferLine = 0;
+    /**
+     * Characters dropped before drawing in the buffer, the line of the
+     * marquee starts further in its text
+     */
+    uint8_t bufferSkip = 0;
+    /**
+     * Characters that didn't fit on the line since the last `drawItem()`
+     */
+    uint8_t bufferClipped = 0;
+    /**
+     * Time between two steps of the marquee in milliseconds, 0 when it is
+     * disabled
+     */
+    uint16_t marqueeInterval = 0;
+    /**
+     * Time of the last step of the marquee
+     */
+    unsigned long marqueeTime = 0;
+    /**
+     * Item under the cursor scrolled by the marquee, `NULL` until the
+     * cursor stays on an item
+     */
+    MenuItem *marqueeItem = NULL;
+    /**
+     * Characters of the item scrolled out of the line on the left
+     */
+    uint8_t marqueeOffset = 0;
+    /**
+     * Characters of the item that don't fit on the line
+     */
+    uint8_t marqueeLength = 0;
+    /**
+     * Version of the item when `marqueeLength` was measured
+     */
+    uint16_t marqueeVersion = 0;
+    /**
+     * Column of the cursor on the display, 255 when unknown
+     */
+    uint8_t lcdCol = 255;
+    /**
+     * Line of the cursor on the display, 255 when unknown
+     */
+    uint8_t lcdLine = 255;
+    /**
+     * Item drawn on each line of the buffer, the line is only drawn again
+     * when another item or another version of the item is drawn on it
+     */
+    MenuItem *rowItems[LCD_MAX_ROWS];
+    /**
+     * Version of the item drawn on each line of the buffer
+     */
+    uint16_t rowVersions[LCD_MAX_ROWS];
+    /**
+     * Last character of each line as drawn by `drawItem()`, it is covered by
+     * the arrows
+     */
+    uint8_t rowLastChars[LCD_MAX_ROWS];
+    /**
+     * Value of `top` when the menu was last drawn
+     */
+    uint8_t drawnTop = 0;
+    /**
+     * Array of menu items
+     */
+    MenuItem **currentMenuTable = NULL;
+    /**
+     * Array of menu items that was last drawn
+     */
+    MenuItem **drawnMenuTable = NULL;
+    /**
+     * Number of menu items in current menu
+     */
+    size_t currentMenuSize = 0;
+    /**
+     * Menu given to `setupLcdWithMenu()`
+     */
+    MenuItem **rootMenu = NULL;
+    /**
+     * Position in a menu left for one of its sub menus
+     */
+    struct NavigationFrame
+    {
+        MenuItem **menu;
+        uint8_t size;
+        uint8_t top;
+        uint8_t bottom;
+        uint8_t cursorPosition;
+    };
+    /**
+     * Menus left for the current one, the last is its parent
+     */
+    NavigationFrame navigationStack[LCD_MENU_MAX_DEPTH];
+    /**
+     * Number of frames in `navigationStack`
+     */
+    uint8_t navigationDepth = 0;
+    /**
+     * Set with `setWrapAround()`, `up()` and `down()` then go from one end
+     * of the menu to the other
+     */
+    bool isWrapAround = false;
+    /**
+     * One bit per item of the current menu, set when the item is visible
+     */
+    uint8_t visibleItems[(MAX_MENU_ITEMS + 7) / 8];
+    /**
+     * Menu for which `visibleItems` was built
+     */
+    MenuItem **visibleItemsMenu = NULL;
+    /**
+     * Value of `MenuItem::getVisibilityRevision()` when `visibleItems` was
+     * built
+     */
+    uint16_t visibleItemsRevision = 0;
+    /**
+     * Down arrow (↓)
+     */
+    byte downArrow[8] = {
+        0b00100, //   *
+        0b00100, //   *
+        0b00100, //   *
+        0b00100, //   *
+        0b00100, //   *
+        0b10101, // * * *
+        0b01110, //  ***
+        0b00100  //   *
+    };
+    /**
+     * Up arrow (↑)
+     */
+    byte upArrow[8] = {
+        0b00100, //   *
+        0b01110, //  ***
+        0b10101, // * * *
+        0b00100, //   *
+        0b00100, //   *
+        0b00100, //   *
+        0b00100, //   *
+        0b00100  //   *
+    };
+    /**
+     * One bit per character of the CGRAM in use, the arrows take the first
+     * two
+     */
+    uint8_t usedGlyphs = 0b00000011;
+    /**
+     * First of the four characters with 1 to 4 filled columns used by the
+     * progress bars, 0 until they are reserved
+     */
+    uint8_t barGlyph = 0;
+    /**
+     * Set once the characters of the bars are sent to the display
+     */
+    bool isBarLoaded = false;
+    /**
+     * Cursor icon. Defaults to right arrow (→).
+     */
+    uint8_t cursorIcon = 0x7E;
+    /**
+     * Edit mode cursor icon. Defaults to left arrow (←).
+     */
+    uint8_t editCursorIcon = 0x7F;
+    /**
+     * Determines whether the screen should be updated after an action. Set it
+     * to `false` when you want to display any other content on the screen then
+     * set it back to `true` to show the menu.
+     */
+    bool enableUpdate = true;
+    /**
+     * The backlight state of the lcd
+     */
+    uint8_t backlightState = HIGH;
+    //
+    // states of the display for the timeout
+    //
+    static const uint8_t POWER_ON = 0;
+    static const uint8_t POWER_DIMMED = 1;
+    static const uint8_t POWER_OFF = 2;
+    uint8_t powerState = POWER_ON;
+    /**
+     * Time before the backlight is dimmed in milliseconds, 0 to switch the
+     * display off without dimming it first
+     */
+    uint16_t dimTimeout = 0;
+    /**
+     * Backlight while dimmed
+     */
+    uint8_t dimBacklight = LOW;
+
+#ifdef ENABLE_MENU_STATS
+    /**
+     * Counters of what the menu did
+     */
+    MenuStats stats;
+    /**
+     * Time when the running callback was called
+     */
+    unsigned long callbackStart = 0;
+    /**
+     * Time when the running render started, 0 when none is running
+     */
+    unsigned long renderStart = 0;
+    /**
+     * Nested renders, only the outermost one is timed
+     */
+    uint8_t renderDepth = 0;
+
+    void beginCallback()
+    {
+        stats.callbacks++;
+        callbackStart = micros();
+    }
+    void endCallback()
+    {
+        uint32_t elapsed = micros() - callbackStart;
+        stats.callbackMicros += elapsed;
+        if (elapsed > stats.maxCallbackMicros)
+            stats.maxCallbackMicros = elapsed;
+    }
+    void beginRender()
+    {
+        if (renderDepth++ == 0)
+            renderStart = micros();
+    }
+    void endRender()
+    {
+        if (--renderDepth == 0)
+            stats.renderMicros += micros() - renderStart;
+    }
+#endif
+
+    /**
+     * ## Private Methods
+     */
+
+    /**
+     * Update the visibility of the items if the current menu has changed or
+     * an item has been hidden or shown since the last time. Only the items
+     * changed since then are updated when they are all in the log of
+     * `MenuItem`, otherwise every item is checked again.
+     */
+    void updateVisibleItems()
+    {
+        uint16_t revision = MenuItem::getVisibilityRevision();
+        if (visibleItemsMenu == currentMenuTable &&
+            (uint16_t)(revision - visibleItemsRevision) <=
+                MENU_VISIBILITY_LOG_SIZE)
+        {
+            while (visibleItemsRevision != revision)
+            {
+                visibleItemsRevision++;
+                updateItemVisibility(
+                    MenuItem::getVisibilityLog()[visibleItemsRevision %
+                                                 MENU_VISIBILITY_LOG_SIZE]);
+            }
+            return;
+        }
+        MENU_STAT(stats.visibilityRebuilds++);
+        memset(visibleItems, 0, sizeof(visibleItems));
+        for (uint8_t i = 0; i < currentMenuSize && i < MAX_MENU_ITEMS; i++)
+        {
+            MENU_STAT(stats.itemsScanned++);
+            if (!currentMenuTable[i]->isHidden())
+            {
+                visibleItems[i >> 3] |= 1 << (i & 7);
+            }
+        }
+        visibleItemsMenu = currentMenuTable;
+        visibleItemsRevision = revision;
+    }
+    /**
+     * Set the bit of an item that was hidden or shown, nothing is done if it
+     * is not in the current menu
+     * @param item item hidden or shown
+     */
+    void updateItemVisibility(MenuItem *item)
+    {
+        for (uint8_t i = 0; i < currentMenuSize && i < MAX_MENU_ITEMS; i++)
+        {
+            if (currentMenuTable[i] != item)
+                continue;
+            if (item->isHidden())
+                visibleItems[i >> 3] &= ~(1 << (i & 7));
+            else
+                visibleItems[i >> 3] |= 1 << (i & 7);
+        }
+    }
+
+    /**
+     * Check if an item of the current menu is visible.
+     * Items past `MAX_MENU_ITEMS` are checked directly.
+     * @param index index of the item
+     * @return 'bool' - true if the item is not hidden
+     */
+    bool isItemVisible(uint8_t index)
+    {
+        if (index >= MAX_MENU_ITEMS)
+        {
+            return !currentMenuTable[index]->isHidden();
+        }
+        return visibleItems[index >> 3] & (1 << (index & 7));
+    }
+
+    /**
+     * Count the visible items in a range of the current menu
+     * @param from index of the first item to count
+     * @param to index after the last item to count
+     * @return 'uint8_t' - Number of non hidden items in [from, to)
+     */
+    uint8_t countVisibleItems(uint8_t from, uint8_t to)
+    {
+        updateVisibleItems();
+        uint8_t res = 0;
+        uint8_t i = from;
+        //
+        // count bit by bit until a byte boundary then byte by byte
+        //
+        for (; i < to && (i & 7); i++)
+        {
+            res += isItemVisible(i);
+        }
+        MENU_STAT(stats.itemsScanned += i - from);
+        for (; i + 8 <= to && i + 8 <= MAX_MENU_ITEMS; i += 8)
+        {
+            MENU_STAT(stats.itemsScanned += 8);
+            for (uint8_t bits = visibleItems[i >> 3]; bits; bits &= bits - 1)
+            {
+                res++;
+            }
+        }
+        for (; i < to; i++)
+        {
+            MENU_STAT(stats.itemsScanned++);
+            res += isItemVisible(i);
+        }
+        return res;
+    }
+
+    /**
+     * Find the first visible item at or after an index.
+     * The footer is never hidden so an item is always found.
+     * @param index index to start from
+     * @return 'uint8_t' - index of the visible item
+     */
+    uint8_t nextVisibleItem(uint8_t index)
+    {
+        updateVisibleItems();
+        while (!isItemVisible(index))
+        {
+            if ((index & 7) == 0 && index + 8 <= MAX_MENU_ITEMS &&
+                visibleItems[index >> 3] == 0)
+            {
+                MENU_STAT(stats.itemsScanned += 8);
+                index += 8;
+            }
+            else
+            {
+                MENU_STAT(stats.itemsScanned++);
+                index++;
+            }
+        }
+        return index;
+    }
+
+    /**
+     * Find the last visible item at or before an index.
+     * The header is never hidden so an item is always found.
+     * @param index index to start from
+     * @return 'uint8_t' - index of the visible item
+     */
+    uint8_t previousVisibleItem(uint8_t index)
+    {
+        updateVisibleItems();
+        while (!isItemVisible(index))
+        {
+            if ((index & 7) == 7 && index < MAX_MENU_ITEMS &&
+                visibleItems[index >> 3] == 0)
+            {
+                MENU_STAT(stats.itemsScanned += 8);
+                index -= 8;
+            }
+            else
+            {
+                MENU_STAT(stats.itemsScanned++);
+                index--;
+            }
+        }
+        return index;
+    }
+
+    /**
+     * Check if items all above the cursor are hidden.
+     * Header is ignored in this check.
+     * @param cursor cursor to use for check
+     * @return 'bool' - true if all items above cursor are hidden
+     * in current menu / submenu
+     */
+    bool checkAllAboveHidden(uint8_t cursor)
+    {
+        return countNonHiddenAbove(cursor) == 0;
+    }
+
+    /**
+     * Check if items all below the cursor are hidden.
+     * Footer is ignored in this check.
+     * @param cursor cursor to use for check
+     * @return 'bool' - true if all items below cursor are hidden
+     * in current menu / submenu
+     */
+    bool checkAllBelowHidden(uint8_t cursor)
+    {
+        return countNonHiddenBelow(cursor) == 0;
+    }
+
+    /**
+     * Count non hidden items above given cursor.
+     * @param cursor cursor to use for check
+     * @return 'uint8_t' - Number of non hidden items above cursor
+     * in current menu / submenu
+     */
+    uint8_t countNonHiddenAbove(uint8_t cursor)
+    {
+        return cursor > 1 ? countVisibleItems(1, cursor) : 0;
+    }
+
+    /**
+     * Count non hidden items below given cursor.
+     * @param cursor cursor to use for check
+     * @return 'uint8_t' - Number of non hidden items below cursor
+     * in current menu / submenu
+     */
+    uint8_t countNonHiddenBelow(uint8_t cursor)
+    {
+        return countVisibleItems(cursor + 1, currentMenuSize - 1);
+    }
+
+    /**
+     * Count non hidden items.
+     * @return 'uint8_t' - Number of non hidden items in current menu / submenu
+     */
+    uint8_t countNonHiddenItems()
+    {
+        return countVisibleItems(1, currentMenuSize - 1);
+    }
+
+    /**
+     * Set the position where the next character is drawn in the buffer
+     * @param col column
+     * @param line line
+     */
+    void bufferSetCursor(uint8_t col, uint8_t line)
+    {
+        bufferCol = col;
+        bufferLine = line;
+    }
+    /**
+     * Draw a character in the buffer, characters past the end of the line
+     * are dropped
+     * @param c character to draw
+     * @return `uint8_t` - number of characters drawn
+     */
+    uint8_t bufferWrite(uint8_t c)
+    {
+        if (bufferSkip)
+        {
+            bufferSkip--;
+            return 0;
+        }
+        if (bufferCol >= maxCols)
+        {
+            bufferClipped++;
+            return 0;
+        }
+        buffer[bufferLine][bufferCol++] = c;
+        return 1;
+    }
+    /**
+     * Draw a text in the buffer
+     * @param text text to draw
+     * @param isInFlash true if `text` is stored in flash memory
+     * @return `uint8_t` - number of characters drawn
+     */
+    uint8_t bufferPrint(const char *text, bool isInFlash = false)
+    {
+        uint8_t n = 0;
+        while (text != NULL)
+        {
+            char c = isInFlash ? pgm_read_byte(text) : *text;
+            if (!c)
+                break;
+            //
+            // the characters past the end of the line are only counted
+            //
+            n += bufferWrite(c);
+            text++;
+        }
+        return n;
+    }
+#ifdef ItemProgress_H
+    /**
+     * Reserve the characters of the progress bars the first time a bar is
+     * drawn, they are sent by the next `flush()`
+     * @return `bool` - false if there are not enough free characters
+     */
+    bool reserveBarGlyphs()
+    {
+        if (!barGlyph)
+        {
+            int8_t slot = reserveGlyphs(4);
+            if (slot < 0)
+                return false;
+            barGlyph = slot;
+        }
+        return true;
+    }
+    /**
+     * Send the characters of the progress bars to the display, before the
+     * first bar drawn or after `setupLcdWithMenu()`
+     */
+    void loadBarGlyphs()
+    {
+        for (uint8_t n = 1; n <= 4; n++)
+        {
+            uint8_t charmap[8];
+            memset(charmap, (0x1F << (5 - n)) & 0x1F, sizeof(charmap));
+            lcd->createChar(barGlyph + n - 1, charmap);
+        }
+        //
+        // the display now points to its CGRAM
+        //
+        lcdLine = 255;
+        isBarLoaded = true;
+    }
+    /**
+     * Draw the bar of a progress in the buffer, a cell changes every fifth of
+     * a character so only one or two characters differ after a step
+     * @param item progress to draw
+     * @param cells number of characters of the bar
+     * @return `uint8_t` - number of characters drawn
+     */
+    uint8_t bufferBar(ItemValue *item, uint8_t cells)
+    {
+        uint16_t fill = item->getBarFill(cells * 5);
+        uint8_t n = 0;
+        for (uint8_t i = 0; i < cells; i++)
+        {
+            uint8_t columns = fill >= 5 ? 5 : fill;
+            fill -= columns;
+            n += bufferWrite(columns == 0   ? ' '
+                             : columns == 5 ? 0xFF
+                                            : barGlyph + columns - 1);
+        }
+        return n;
+    }
+#endif
+    /**
+     * Get the length of the text of an item
+     * @param item item to measure
+     * @return `uint8_t` - number of characters of the text
+     */
+    uint8_t getTextLength(MenuItem *item)
+    {
+        return item->isTextInFlash() ? strlen_P(item->getText())
+                                     : strlen(item->getText());
+    }
+    /**
+     * Send the characters that changed since the last flush to the display.
+     * Unchanged characters are skipped, the cursor of the display is only
+     * moved at the start of each run of changed characters.
+     * The comparison resumes where the previous flush stopped.
+     * @param maxChars maximum number of characters to send, 0 for no limit
+     * @param maxMicros maximum time to spend sending characters in
+     * microseconds, 0 for no limit
+     * @return `bool` - true if the display matches the buffer
+     */
+    bool flush(uint8_t maxChars = 0, uint16_t maxMicros = 0)
+    {
+        unsigned long startMicros = maxMicros ? micros() : 0;
+        uint8_t sent = 0;
+        MENU_STAT(beginRender());
+#ifdef ItemProgress_H
+        //
+        // the bars drawn in the buffer need their characters first
+        //
+        if (barGlyph && !isBarLoaded)
+            loadBarGlyphs();
+#endif
+        for (uint16_t n = maxRows * maxCols; n > 0; n--)
+        {
+            uint8_t line = flushLine;
+            uint8_t col = flushCol;
+            uint8_t c = buffer[line][col];
+            if (c != screen[line][col] || isScreenInvalid)
+            {
+                if ((maxChars && sent >= maxChars) ||
+                    (maxMicros && sent && micros() - startMicros >= maxMicros))
+                {
+                    lcd->flush();
+                    MENU_STAT(endRender());
+                    return false;
+                }
+                if (col != lcdCol || line != lcdLine)
+                {
+                    lcd->setCursor(col, line);
+                    MENU_STAT(stats.cursorMoves++);
+                    lcdLine = line;
+                }
+                lcd->write(c);
+                MENU_STAT(stats.charsWritten++);
+                screen[line][col] = c;
+                lcdCol = col + 1;
+                sent++;
+            }
+            if (++flushCol == maxCols)
+            {
+                flushCol = 0;
+                if (++flushLine == maxRows)
+                {
+                    // every character was sent at least once
+                    flushLine = 0;
+                    isScreenInvalid = false;
+                }
+            }
+        }
+        if (sent)
+        {
+            lcd->flush();
+        }
+        MENU_STAT(endRender());
+        return true;
+    }
+    /**
+     * Check if the changes are sent by `poll()` instead of immediately
+     * @return `bool` - true if a render budget is set
+     */
+    bool isRenderSliced() { return renderBudget || renderTimeBudget; }
+    /**
+     * Check if the changes are kept in the buffer instead of being sent
+     * immediately, either to `poll()` or until the display wakes up
+     * @return `bool` - true if rendering in slices or the display is off
+     */
+    bool isRenderDeferred()
+    {
+        return isRenderSliced() || powerState == POWER_OFF;
+    }
+    /**
+     * Place the blinker on the input being edited, or stop blinking
+     */
+    void drawBlinker()
+    {
+#ifdef ItemInput_H
+        //
+        // If cursor is at MENU_ITEM_INPUT enable blinking
+        //
+        MenuItem *item = currentMenuTable[cursorPosition];
+        if (item->getType() == MENU_ITEM_INPUT)
+        {
+            resetBlinker();
+            if (isEditModeEnabled)
+            {
+                lcd->blink();
+                return;
+            }
+        }
+#endif
+        lcd->noBlink();
+    }
+    /**
+     * Draws the cursor
+     */
+    void drawCursor()
+    {
+        if (isBatching)
+        {
+            isRedrawPending = true;
+            return;
+        }
+        //
+        // Erases current cursor
+        //
+        for (uint8_t x = 0; x < maxRows; x++)
+        {
+            buffer[x][0] = ' ';
+        }
+        //
+        // draws a new cursor at [line]
+        //
+        uint8_t line = constrain(cursorPosition - top, 0, maxRows - 1);
+
+        // TODO: for LCDs with more rows than 2?
+        if (checkAllAboveHidden(cursorPosition))
+        {
+            line = 0;
+        }
+
+        buffer[line][0] = isEditModeEnabled ? editCursorIcon : cursorIcon;
+        //
+        // the frame is sent by poll() when rendering in slices
+        //
+        if (isRenderDeferred())
+        {
+            isFrameDirty = true;
+            isBlinkerDirty = true;
+            return;
+        }
+        flush();
+        drawBlinker();
+    }
+    /**
+     * Draw a single item on a line, the line is padded with spaces so the
+     * previous content gets overwritten without clearing the display.
+     * The cursor is erased and must be drawn again.
+     * @param item item to draw
+     * @param line line on the display
+     */
+    void drawItem(MenuItem *item, uint8_t line)
+    {
+        if (rowItems[line] == item && rowVersions[line] == item->getVersion())
+        {
+            //
+            // the line already shows this item, only erase the arrow, the
+            // arrows are left as they are while editing
+            //
+            if (!isEditModeEnabled)
+                buffer[line][maxCols - 1] = rowLastChars[line];
+            return;
+        }
+        //
+        // the item moved to another line when scrolling, copy its line
+        //
+        for (uint8_t r = 0; r < maxRows; r++)
+        {
+            if (r != line && rowItems[r] == item &&
+                rowVersions[r] == item->getVersion())
+            {
+                MENU_STAT(stats.rowsReused++);
+                memcpy(buffer[line], buffer[r], maxCols);
+                buffer[line][maxCols - 1] = rowLastChars[r];
+                rowItems[line] = item;
+                rowVersions[line] = rowVersions[r];
+                rowLastChars[line] = rowLastChars[r];
+                return;
+            }
+        }
+        MENU_STAT(stats.itemDraws++; stats.virtualCalls++);
+        bufferSetCursor(0, line);
+        bufferClipped = 0;
+        uint8_t col = bufferWrite(' ');
+        bufferSkip = item == marqueeItem ? marqueeOffset : 0;
+        if (item->getType() != MENU_ITEM_END_OF_MENU)
+        {
+            col += bufferPrint(item->getText(), item->isTextInFlash());
+        }
+        //
+        // determine the type of item
+        //
+        switch (item->getType())
+        {
+#ifdef ItemToggle_H
+        case MENU_ITEM_TOGGLE:
+            //
+            // append textOn or textOff depending on the state
+            //
+            col += bufferWrite(':');
+            {
+                ItemToggle *toggle = static_cast<ItemToggle *>(item);
+                col += bufferPrint(toggle->isOn() ? toggle->getTextOn()
+                                                  : toggle->getTextOff());
+            }
+            break;
+#endif
+#ifdef ItemInput_H
+        case MENU_ITEM_INPUT:
+            //
+            // append the value of the input
+            //
+            col += bufferWrite(':');
+            col += bufferPrint(static_cast<ItemInput *>(item)->getValue());
+            break;
+#endif
+#ifdef ItemLive_H
+        case MENU_ITEM_LIVE:
+            //
+            // append the last value read
+            //
+            col += bufferWrite(':');
+            col += bufferPrint(static_cast<ItemLive *>(item)->getValue());
+            break;
+#endif
+#ifdef ItemProgress_H
+        case MENU_ITEM_PROGRESS:
+            //
+            // append the value of the progress, virtual as `ItemNumber` shares
+            // the type
+            //
+            MENU_STAT(stats.virtualCalls += 2);
+            col += bufferWrite(':');
+            {
+                ItemValue *value = static_cast<ItemValue *>(item);
+                uint8_t cells = value->getBarCells();
+                if (cells && reserveBarGlyphs())
+                    col += bufferBar(value, cells);
+                else
+                    col += bufferPrint(item->getValue());
+            }
+            break;
+#endif
+#ifdef ItemList_H
+        case MENU_ITEM_LIST:
+            //
+            // append the value of the item at current list position
+            //
+            col += bufferWrite(':');
+            {
+                ItemList *list = static_cast<ItemList *>(item);
+                MenuText value = list->getItemText(list->getItemIndex());
+                col += bufferPrint(value.text, value.isInFlash);
+            }
+            break;
+#endif
+        default:
+            break;
+        }
+        //
+        // clear what is left of the line
+        //
+        bufferSkip = 0;
+        while (col < maxCols)
+        {
+            col += bufferWrite(' ');
+        }
+        rowItems[line] = item;
+        rowVersions[line] = item->getVersion();
+        rowLastChars[line] = buffer[line][maxCols - 1];
+    }
+    /**
+     * Forget the items drawn on the lines, they are all drawn again
+     */
+    void resetRowCache() { memset(rowItems, 0, sizeof(rowItems)); }
+    /**
+     * Find the item drawn on a line of the display, skipping hidden items
+     * @param line line on the display
+     * @return index of the item in the current menu, the index of the footer
+     * if the line is past the end of the menu
+     */
+    uint8_t getItemIndexAtLine(uint8_t line)
+    {
+        uint8_t t = top;
+        for (uint8_t l = 0;; l++)
+        {
+            t = nextVisibleItem(t);
+            if (l == line ||
+                currentMenuTable[t]->getType() == MENU_ITEM_END_OF_MENU)
+            {
+                return t;
+            }
+            t++;
+        }
+    }
+    /**
+     * Check if the current menu is a `VirtualMenu` whose window can move
+     * @param isDown true to check the entries after the window
+     * @return `bool` - true if there are entries outside of the window
+     */
+    bool canScrollWindow(bool isDown)
+    {
+#ifdef VirtualMenu_H
+        VirtualMenu *menu = getVirtualMenu();
+        return menu != NULL && menu->canScroll(isDown);
+#else
+        (void)isDown;
+        return false;
+#endif
+    }
+    /**
+     * Move the window of the current menu if it is a `VirtualMenu`
+     * @param isDown true to move to the next entry
+     */
+    void scrollWindow(bool isDown)
+    {
+#ifdef VirtualMenu_H
+        VirtualMenu *menu = getVirtualMenu();
+        if (menu != NULL)
+            menu->scroll(isDown);
+#else
+        (void)isDown;
+#endif
+    }
+#ifdef VirtualMenu_H
+    /**
+     * Get the current menu if it is a `VirtualMenu`
+     * @return `VirtualMenu*` - the menu, `NULL` for other menus
+     */
+    VirtualMenu *getVirtualMenu()
+    {
+        MenuItem *header = currentMenuTable[0];
+        return header->getType() == MENU_ITEM_VIRTUAL_MENU
+                   ? static_cast<VirtualMenu *>(header)
+                   : NULL;
+    }
+#endif
+    /**
+     * Draw the up and down indicators
+     */
+    void drawArrows()
+    {
+        if (isEditModeEnabled)
+        {
+            return;
+        }
+
+        bool isMoreAbove = canScrollWindow(false);
+        bool isMoreBelow = canScrollWindow(true);
+
+        // All entries fit the LCD so no arrows needed
+        uint8_t nonHidden = countNonHiddenItems();
+        if (nonHidden <= maxRows && !isMoreAbove && !isMoreBelow)
+        {
+            return;
+        }
+
+        uint8_t cursorLine = constrain(cursorPosition - top, 0, maxRows - 1);
+
+        // TODO: for LCDs with more rows than 2?
+        if (checkAllAboveHidden(cursorPosition) && cursorLine)
+        {
+            cursorLine = 0;
+        }
+
+        uint8_t firstDrawnItemIdx = getItemIndexAtLine(0);
+        uint8_t lastDrawnItemIdx = getItemIndexAtLine(maxRows - 1);
+        if (currentMenuTable[lastDrawnItemIdx]->getType() ==
+            MENU_ITEM_END_OF_MENU)
+        {
+            lastDrawnItemIdx--;
+        }
+
+        // Print up arrow
+        if ((cursorLine == 0 && !checkAllAboveHidden(firstDrawnItemIdx) && cursorPosition > 1) ||
+            (cursorLine != 0 && countNonHiddenAbove(firstDrawnItemIdx)) ||
+            isMoreAbove)
+        {
+            buffer[0][maxCols - 1] = byte(0);
+        }
+
+        // Print down arrow
+        if (countNonHiddenBelow(lastDrawnItemIdx) || isMoreBelow)
+        {
+            buffer[maxRows - 1][maxCols - 1] = byte(1);
+        }
+    }
+    /**
+     * Draw the menu items with up and down indicators
+     */
+    void drawMenu()
+    {
+        MENU_STAT(stats.menuDraws++);
+        //
+        // print the menu items
+        //
+        MenuItem *items[LCD_MAX_ROWS];
+        uint8_t t = top;
+        for (uint8_t line = 0; line < maxRows; line++)
+        {
+            t = nextVisibleItem(t);
+            items[line] = currentMenuTable[t];
+            // past the end of menu only empty lines are left
+            if (items[line]->getType() == MENU_ITEM_END_OF_MENU)
+                continue;
+
+            t++;
+        }
+        //
+        // when scrolling up the lines move down, draw them from the bottom so
+        // each line is copied before being drawn over
+        //
+        bool isScrollingUp =
+            currentMenuTable == drawnMenuTable && top < drawnTop;
+        for (uint8_t n = 0; n < maxRows; n++)
+        {
+            uint8_t line = isScrollingUp ? maxRows - 1 - n : n;
+            drawItem(items[line], line);
+        }
+
+        drawnTop = top;
+        drawnMenuTable = currentMenuTable;
+
+        drawArrows();
+    }
+    /**
+     * Draw what changed since the last time, e.g. the cursor after a move,
+     * an item hidden by a callback or a value set by the sketch. The lines
+     * whose item did not change are skipped by the row cache.
+     */
+    void drawChanges()
+    {
+        if (!enableUpdate)
+            return;
+        if (isBatching)
+        {
+            isRedrawPending = true;
+            return;
+        }
+        MENU_STAT(beginRender());
+        drawMenu();
+        drawCursor();
+        MENU_STAT(endRender());
+    }
+
+    /**
+     * Check if the cursor is at the start of the menu items
+     * @return true : `bool` if it is at the start
+     */
+    bool isAtTheStart()
+    {
+        return checkAllAboveHidden(cursorPosition) && !canScrollWindow(false);
+    }
+
+    /**
+     * Check if the cursor is at the end of the menu items
+     * @return true : `bool` if it is at the end
+     */
+    bool isAtTheEnd()
+    {
+        return checkAllBelowHidden(cursorPosition) && !canScrollWindow(true);
+    }
+
+    /**
+     * Make a menu the current one with the given position
+     * @param menu menu to show
+     * @param size number of items in `menu`
+     */
+    void setCurrentMenu(MenuItem **menu, size_t size, uint8_t top,
+                        uint8_t bottom, uint8_t cursorPosition)
+    {
+        currentMenuTable = menu;
+        currentMenuSize = size;
+        this->top = top;
+        this->bottom = bottom;
+        this->cursorPosition = cursorPosition;
+    }
+
+    /**
+     * Restore the position saved in a frame of the navigation stack
+     * @param frame frame to restore
+     */
+    void restoreFrame(const NavigationFrame &frame)
+    {
+        setCurrentMenu(frame.menu, frame.size, frame.top, frame.bottom,
+                       frame.cursorPosition);
+    }
+
+    void enterSubMenu(MenuItem *item)
+    {
+        if (item->getSubMenu() == NULL)
+            return;
+        //
+        // save the position in the current menu, the oldest is dropped when
+        // the stack is full
+        //
+        if (navigationDepth == LCD_MENU_MAX_DEPTH)
+        {
+            memmove(navigationStack, navigationStack + 1,
+                    sizeof(NavigationFrame) * (LCD_MENU_MAX_DEPTH - 1));
+            navigationDepth--;
+        }
+        navigationStack[navigationDepth++] = {
+            currentMenuTable, (uint8_t)currentMenuSize, top, bottom,
+            cursorPosition};
+
+        MenuItem **menu = item->getSubMenu();
+        setCurrentMenu(menu, getMenuSize(menu), 1, maxRows, 1);
+
+        update();
+    }
+
+    void leaveSubMenu()
+    {
+        if (navigationDepth)
+        {
+            restoreFrame(navigationStack[--navigationDepth]);
+        }
+        else
+        {
+            //
+            // entered deeper than the stack, use the parent of the header
+            //
+            MenuItem **parent = currentMenuTable[0]->getSubMenu();
+            if (parent == NULL)
+                return;
+            setCurrentMenu(parent, getMenuSize(parent), 1, maxRows, 1);
+        }
+
+        update();
+    }
+
+    /**
+     * Put the cursor on an item of the current menu without drawing, the
+     * window moves so the item is on its first line, or lower near the end
+     * of the menu so the window stays full. The window only goes back over
+     * visible items for the line of the cursor to match its position.
+     * @param index index of a visible item
+     */
+    void placeCursor(uint8_t index)
+    {
+        updateVisibleItems();
+        top = index;
+        while (top > 1 && isItemVisible(top - 1) &&
+               countVisibleItems(top, currentMenuSize - 1) < maxRows)
+        {
+            top--;
+        }
+        bottom = top + maxRows - 1;
+        cursorPosition = index;
+    }
+
+    /**
+     * Put the cursor on an item and draw the changes, see `placeCursor()`
+     * @param index index of a visible item
+     */
+    void showItem(uint8_t index)
+    {
+        placeCursor(index);
+        drawChanges();
+    }
+
+    /**
+     * Leave the edit mode without drawing or calling the callbacks, a list
+     * or a progress gets back the value it had before the edit
+     */
+    void cancelEdit()
+    {
+        isEditModeEnabled = false;
+#if defined(ItemProgress_H) || defined(ItemList_H)
+        MenuItem *item = currentMenuTable[cursorPosition];
+        if (item->getType() == MENU_ITEM_LIST ||
+            item->getType() == MENU_ITEM_PROGRESS)
+        {
+            item->restoreProgress();
+            //
+            // the value is back to the one the sketch knows
+            //
+            if (changedItem == item)
+                changedItem = NULL;
+        }
+#endif
+    }
+
+    /**
+     * Go to the other end of the menu if `setWrapAround()` was enabled,
+     * the window of a `VirtualMenu` is not wrapped
+     * @param isDown true when the cursor is on the last item
+     * @return `bool` - true if the cursor moved
+     */
+    bool wrapAround(bool isDown)
+    {
+        if (!isWrapAround || canScrollWindow(false) || canScrollWindow(true) ||
+            countNonHiddenItems() < 2)
+            return false;
+        updateVisibleItems();
+        showItem(isDown ? nextVisibleItem(1)
+                        : previousVisibleItem(currentMenuSize - 2));
+        return true;
+    }
+
+    /**
+     * Move a page in a `VirtualMenu`, whose window moves one entry at a time,
+     * by moving the cursor once per line and drawing at the end
+     * @param isDown true to move down
+     * @return `bool` - true if the cursor moved
+     */
+    bool moveVirtualPage(bool isDown)
+    {
+        bool wasBatching = isBatching;
+        isBatching = true;
+        bool isMoved = false;
+        for (uint8_t n = 0; n < maxRows && (isDown ? down() : up()); n++)
+        {
+            isMoved = true;
+        }
+        isBatching = wasBatching;
+        if (!isBatching && isRedrawPending)
+        {
+            isRedrawPending = false;
+            update();
+        }
+        return isMoved;
+    }
+
+    /**
+     * Read the first character of the text of an item
+     * @param item item to read
+     * @return `uint8_t` - the character in upper case, 0 if there is no text
+     */
+    uint8_t readItemLetter(MenuItem *item)
+    {
+        const char *text = item->getText();
+        char c = text == NULL            ? '\0'
+                 : item->isTextInFlash() ? pgm_read_byte(text)
+                                         : *text;
+        return toupper(c);
+    }
+
+    /**
+     * Find the items to enter to reach a menu from another one
+     * @param from menu to search
+     * @param menu menu to find
+     * @param path receives the index of the sub menu item in each level
+     * @param depth number of levels already in `path`
+     * @return `uint8_t` - number of levels in `path`, 0 if not found
+     */
+    uint8_t findPath(MenuItem **from, MenuItem **menu, uint8_t *path,
+                     uint8_t depth)
+    {
+        if (depth == LCD_MENU_MAX_DEPTH)
+            return 0;
+        size_t size = getMenuSize(from);
+        for (uint8_t i = 1; i < size - 1; i++)
+        {
+            if (from[i]->getType() != MENU_ITEM_SUB_MENU)
+                continue;
+            MenuItem **subMenu = from[i]->getSubMenu();
+            if (subMenu == NULL)
+                continue;
+            path[depth] = i;
+            if (subMenu == menu)
+                return depth + 1;
+            uint8_t length = findPath(subMenu, menu, path, depth + 1);
+            if (length)
+                return length;
+        }
+        return 0;
+    }
+
+#ifdef ItemInput_H
+    /**
+     * Calculate and set the new blinker position
+     */
+    void resetBlinker()
+    {
+        //
+        // calculate lower and upper bound
+        //
+        ItemInput *input = static_cast<ItemInput *>(currentMenuTable[cursorPosition]);
+        uint8_t lb = getTextLength(input) + 2;
+        uint8_t ub = lb + strlen(input->getValue());
+        ub = constrain(ub, lb, maxCols - 2);
+        //
+        // set cursor position
+        //
+        blinkerPosition = constrain(blinkerPosition, lb, ub);
+        if (isBatching)
+        {
+            isRedrawPending = true;
+            return;
+        }
+        lcd->setCursor(blinkerPosition, cursorPosition - top);
+        lcd->flush();
+        lcdCol = blinkerPosition;
+        lcdLine = cursorPosition - top;
+    }
+    /**
+     * Write a character in the value of the input at the blinker position
+     * @param character character to write
+     * @param isInsert true to insert the character, false to overwrite it
+     */
+    void editValue(char character, bool isInsert)
+    {
+        wake();
+        MenuItem *item = currentMenuTable[cursorPosition];
+        //
+        if (item->getType() != MENU_ITEM_INPUT || !isEditModeEnabled)
+            return;
+        ItemInput *input = static_cast<ItemInput *>(item);
+        //
+        uint8_t lb = getTextLength(item) + 2;
+        //
+        // the value is edited in place, nothing is allocated for inputs
+        // without a buffer, they can't be edited
+        //
+        if (!input->getCapacity())
+            return;
+        //
+        // update text
+        //
+        uint8_t index = blinkerPosition - lb;
+        bool isWritten = isInsert ? input->insertChar(index, character)
+                                  : input->replaceChar(index, character);
+        //
+        isCharPickerActive = false;
+        //
+        // update blinker position
+        //
+        if (isWritten)
+            blinkerPosition++;
+        //
+        // repaint item
+        //
+        drawChanges();
+    }
+#endif
+#if defined(ItemProgress_H) || defined(ItemList_H)
+    /**
+     * Start editing the value of an item, its change callback is not called
+     * by the setters when it is deferred
+     * @return `uint16_t` - version of the item before the edit
+     */
+    uint16_t beginChange(MenuItem *item)
+    {
+        if (changeInterval)
+            item->setChangeDeferred(true);
+        return item->getVersion();
+    }
+    /**
+     * Finish editing the value of an item, remember to call its change
+     * callback later if the value changed
+     * @param item edited item
+     * @param version version of the item before the edit
+     */
+    void endChange(MenuItem *item, uint16_t version)
+    {
+        item->setChangeDeferred(false);
+        if (!changeInterval)
+            return;
+        if (item->getVersion() == version)
+            return;
+        unsigned long now = millis();
+        if (changedItem != item)
+        {
+            notifyChange(true);
+            changedItem = item;
+            firstChangeTime = now;
+        }
+        lastChangeTime = now;
+    }
+    /**
+     * Call the deferred change callback with the latest value once the
+     * interval is over
+     * @param isForced true to call it right away
+     */
+    void notifyChange(bool isForced)
+    {
+        if (changedItem == NULL)
+            return;
+        unsigned long since = isChangeNotifiedOnSettle ? lastChangeTime
+                                                       : firstChangeTime;
+        if (!isForced && millis() - since < changeInterval)
+            return;
+        MenuItem *item = changedItem;
+        changedItem = NULL;
+        fptrInt changeCallback =
+            static_cast<ItemValue *>(item)->getChangeCallback();
+        if (changeCallback != NULL)
+        {
+            MENU_STAT(beginCallback());
+            changeCallback(item->getItemIndex());
+            MENU_STAT(endCallback());
+        }
+    }
+#endif
+#ifdef ItemProgress_H
+    /**
+     * Move the progress being edited, faster when the adjustments are
+     * repeated quickly
+     * @param item progress to move
+     * @param steps number of steps, negative to decrement
+     */
+    void adjustProgress(MenuItem *item, int16_t steps)
+    {
+        unsigned long now = millis();
+        bool isUp = steps > 0;
+        if (accelerationInterval)
+        {
+            //
+            // the speed doubles every 4 quick repeats, up to 16 times
+            //
+            if (now - lastAdjustTime < accelerationInterval &&
+                isUp == isLastAdjustUp)
+            {
+                if (adjustRepeats < 16)
+                    adjustRepeats++;
+            }
+            else
+            {
+                adjustRepeats = 0;
+            }
+            int32_t scaled = (int32_t)steps << (adjustRepeats / 4);
+            steps = constrain(scaled, -INT16_MAX, INT16_MAX);
+        }
+        lastAdjustTime = now;
+        isLastAdjustUp = isUp;
+        uint16_t version = beginChange(item);
+        static_cast<ItemValue *>(item)->adjust(steps);
+        endChange(item, version);
+        drawProgress();
+    }
+#endif
+    /**
+     * Find the line the item at the cursor is drawn on
+     * @return `uint8_t` - line, 255 if the menu drawn is outdated
+     */
+    uint8_t getCursorLine()
+    {
+        if (top != drawnTop || currentMenuTable != drawnMenuTable)
+            return 255;
+        for (uint8_t line = 0; line < maxRows; line++)
+        {
+            if (getItemIndexAtLine(line) == cursorPosition)
+                return line;
+        }
+        return 255;
+    }
+    /**
+     * Draw a line of the menu again with the cursor and the arrows
+     * @param item item on the line
+     * @param line line to draw
+     */
+    void redrawLine(MenuItem *item, uint8_t line)
+    {
+        MENU_STAT(beginRender());
+        rowItems[line] = NULL;
+        drawItem(item, line);
+        if (line == 0 || line == maxRows - 1)
+            drawArrows();
+        drawCursor();
+        MENU_STAT(endRender());
+    }
+    /**
+     * Put the text of the marquee back at its start
+     */
+    void stopMarquee()
+    {
+        MenuItem *item = marqueeItem;
+        marqueeItem = NULL;
+        if (item == NULL || !marqueeOffset)
+            return;
+        marqueeOffset = 0;
+        //
+        // the lines drawn with the offset must be drawn again
+        //
+        for (uint8_t line = 0; line < maxRows; line++)
+        {
+            if (rowItems[line] == item)
+                rowItems[line] = NULL;
+        }
+        uint8_t line = getCursorLine();
+        if (enableUpdate && !isBatching && line != 255 &&
+            currentMenuTable[cursorPosition] == item)
+            redrawLine(item, line);
+    }
+    /**
+     * Move the text of the item at the cursor one character to the left
+     * once per `marqueeInterval`, it starts over after its last character
+     */
+    void updateMarquee()
+    {
+        if (!marqueeInterval || !enableUpdate || isBatching)
+            return;
+        MenuItem *item = currentMenuTable[cursorPosition];
+        if (item != marqueeItem || isEditModeEnabled ||
+            powerState == POWER_OFF)
+        {
+            stopMarquee();
+            if (!isEditModeEnabled && powerState != POWER_OFF)
+            {
+                marqueeItem = item;
+                marqueeLength = 0;
+                marqueeVersion = item->getVersion() - 1;
+            }
+            marqueeTime = millis();
+            return;
+        }
+        unsigned long now = millis();
+        if (now - marqueeTime < marqueeInterval)
+            return;
+        marqueeTime = now;
+        uint8_t line = getCursorLine();
+        if (line == 255)
+            return;
+        //
+        // measure the text again when it changes
+        //
+        if (marqueeVersion != item->getVersion())
+        {
+            marqueeOffset = 0;
+            redrawLine(item, line);
+            marqueeLength = bufferClipped;
+            marqueeVersion = item->getVersion();
+            return;
+        }
+        if (!marqueeLength)
+            return;
+        marqueeOffset = marqueeOffset < marqueeLength ? marqueeOffset + 1 : 0;
+        redrawLine(item, line);
+    }
+#ifdef ItemLive_H
+    /**
+     * Read the values of the live items on the display whose interval has
+     * elapsed and draw the lines of those that changed
+     */
+    void refreshLiveItems()
+    {
+        if (!enableUpdate || isBatching || powerState == POWER_OFF ||
+            top != drawnTop || currentMenuTable != drawnMenuTable)
+            return;
+        unsigned long now = millis();
+        bool isChanged = false;
+        uint8_t t = top;
+        for (uint8_t line = 0; line < maxRows; line++)
+        {
+            t = nextVisibleItem(t);
+            MenuItem *item = currentMenuTable[t];
+            if (item->getType() == MENU_ITEM_END_OF_MENU)
+                break;
+            t++;
+            if (item->getType() != MENU_ITEM_LIVE)
+                continue;
+            ItemLive *live = static_cast<ItemLive *>(item);
+            if (!live->isDue(now) || !live->refresh())
+                continue;
+            MENU_STAT(beginRender());
+            drawItem(live, line);
+            MENU_STAT(endRender());
+            isChanged = true;
+        }
+        if (!isChanged)
+            return;
+        MENU_STAT(beginRender());
+        drawArrows();
+        drawCursor();
+        MENU_STAT(endRender());
+    }
+#endif
+#ifdef ItemProgress_H
+    /**
+     * Redraw the progress being edited unless it was redrawn less than
+     * `progressRefreshInterval` ago
+     */
+    void drawProgress()
+    {
+        unsigned long now = millis();
+        if (progressRefreshInterval &&
+            now - lastProgressDrawTime < progressRefreshInterval)
+        {
+            isProgressDirty = true;
+            return;
+        }
+        lastProgressDrawTime = now;
+        isProgressDirty = false;
+        drawChanges();
+    }
+#endif
+
+public:
+    /**
+     * ## Public Fields
+     */
+
+    /**
+     * Time when the timer started in milliseconds
+     */
+    unsigned long startTime = 0;
+    /**
+     * How long should the display stay on
+     */
+    uint16_t timeout = 10000;
+    /**
+     * LCD Display
+     */
+    Display *lcd = NULL;
+
+    /**
+     * # Constructor
+     */
+
+    /**
+     * Constructor for the GenericLcdMenu class
+     * @param maxRows rows on lcd display e.g. 4 (at most `LCD_MAX_ROWS`)
+     * @param maxCols columns on lcd display e.g. 20 (at most `LCD_MAX_COLS`)
+     * @return new `GenericLcdMenu` object
+     */
+    GenericLcdMenu(uint8_t maxRows, uint8_t maxCols)
+        : bottom(min(maxRows, LCD_MAX_ROWS)),
+          maxRows(min(maxRows, LCD_MAX_ROWS)),
+          maxCols(min(maxCols, LCD_MAX_COLS)) {}
+
+    /**
+     * ## Public Methods
+     */
+
+    /**
+     * Call this function in `setup()` to show the menu on an initialized
+     * display, the custom characters used as up and down arrows are created
+     * @param display display to draw the menu on, it must outlive the menu
+     * @param menu menu to display
+     */
+    void setupLcdWithMenu(Display &display, MenuItem **menu)
+    {
+        lcd = &display;
+        lcd->clear();
+        lcd->createChar(0, upArrow);
+        lcd->createChar(1, downArrow);
+        isBarLoaded = false;
+        memset(buffer, ' ', sizeof(buffer));
+        memset(screen, ' ', sizeof(screen));
+        resetRowCache();
+        isScreenInvalid = false;
+        lcdLine = 255;
+        this->rootMenu = menu;
+        this->navigationDepth = 0;
+        this->currentMenuTable = menu;
+        this->currentMenuSize = getMenuSize(currentMenuTable);
+        lcd->display();
+        lcd->setBacklight(backlightState);
+        powerState = POWER_ON;
+        this->startTime = millis();
+        update();
+    }
+
+    void setupLcdWithMenu(Display &display, MenuItem **menu, uint16_t timeout)
+    {
+        this->setupLcdWithMenu(display, menu);
+        this->timeout = timeout;
+    }
+    /*
+     * Draw the menu items and cursor
+     */
+    void update()
+    {
+        if (!enableUpdate)
+            return;
+        if (isBatching)
+        {
+            isRedrawPending = true;
+            return;
+        }
+        MENU_STAT(stats.updates++; beginRender());
+        drawMenu();
+        drawCursor();
+        MENU_STAT(endRender());
+    }
+
+    /**
+     * Queue an event to be processed by `processEvents()` or `poll()`.
+     * It is safe to call from an interrupt, e.g. for a rotary encoder.
+     * @param event one of `MENU_EVENT_UP`, `MENU_EVENT_DOWN`,
+     * `MENU_EVENT_LEFT`, `MENU_EVENT_RIGHT`, `MENU_EVENT_ENTER` or
+     * `MENU_EVENT_BACK`
+     * @return `bool` - false if the queue is full and the event is dropped
+     */
+    bool pushEvent(byte event)
+    {
+        uint8_t next = (eventHead + 1) % MENU_EVENT_QUEUE_SIZE;
+        if (next == eventTail)
+            return false;
+        eventQueue[eventHead] = event;
+        eventHead = next;
+        return true;
+    }
+    /**
+     * Execute the queued events then draw the menu once for all of them,
+     * e.g. five queued down events scroll the menu by five items with a
+     * single redraw.
+     */
+    void processEvents()
+    {
+        if (isBatching)
+            return;
+        isBatching = true;
+        //
+        // events queued while processing wait for the next call
+        //
+        for (uint8_t n = MENU_EVENT_QUEUE_SIZE; n > 0 && eventTail != eventHead;
+             n--)
+        {
+            byte event = eventQueue[eventTail];
+            eventTail = (eventTail + 1) % MENU_EVENT_QUEUE_SIZE;
+            switch (event)
+            {
+            case MENU_EVENT_UP:
+                up();
+                break;
+            case MENU_EVENT_DOWN:
+                down();
+                break;
+            case MENU_EVENT_LEFT:
+                left();
+                break;
+            case MENU_EVENT_RIGHT:
+                right();
+                break;
+            case MENU_EVENT_ENTER:
+                enter();
+                break;
+            case MENU_EVENT_BACK:
+                back();
+                break;
+            }
+        }
+        isBatching = false;
+        if (isRedrawPending)
+        {
+            isRedrawPending = false;
+            update();
+        }
+    }
+    /**
+     * Process the queued events then send a slice of the pending changes to
+     * the display, call it from `loop()` when using `pushEvent()`, when
+     * the rendering is time sliced with `setRenderBudget()` or to refresh
+     * the `ItemLive` items.
+     * @return `bool` - true if changes are still waiting to be sent
+     */
+    bool poll() { return poll(renderTimeBudget); }
+    /**
+     * Same as `poll()` with another time budget for this call, used to share
+     * one budget between several menus, see `MenuScheduler`
+     * @param maxMicros time spent sending characters in microseconds, 0 for
+     * no limit
+     * @return `bool` - true if changes are still waiting to be sent
+     */
+    bool poll(uint16_t maxMicros)
+    {
+        processEvents();
+#ifdef ItemProgress_H
+        if (isProgressDirty)
+            drawProgress();
+#endif
+#if defined(ItemProgress_H) || defined(ItemList_H)
+        notifyChange(false);
+#endif
+#ifdef ItemLive_H
+        refreshLiveItems();
+#endif
+        updateMarquee();
+        if (!isFrameDirty || !enableUpdate || powerState == POWER_OFF)
+            return false;
+        if (!flush(renderBudget, maxMicros))
+            return true;
+        isFrameDirty = false;
+        if (isBlinkerDirty)
+        {
+            isBlinkerDirty = false;
+            drawBlinker();
+        }
+        return false;
+    }
+    /**
+     * Render the menu in slices instead of sending the whole screen at once.
+     * The actions then only draw the menu in memory and every call to
+     * `poll()` sends at most `maxChars` characters or spends at most
+     * `maxMicros` microseconds, the first character is always sent.
+     * Set both to 0 to send the changes immediately again.
+     * @param maxChars characters sent per call to `poll()`, 0 for no limit
+     * @param maxMicros time budget per call to `poll()` in microseconds, 0
+     * for no limit
+     */
+    void setRenderBudget(uint8_t maxChars, uint16_t maxMicros = 0)
+    {
+        renderBudget = maxChars;
+        renderTimeBudget = maxMicros;
+        if (!isRenderSliced())
+        {
+            //
+            // send what is left of the frame
+            //
+            while (poll())
+                ;
+        }
+    }
+#if defined(ItemProgress_H) || defined(ItemList_H)
+    /**
+     * Defer the change callbacks of lists and progress items, they are
+     * called by `poll()` with the latest value and the values in between
+     * are dropped. The pending callback is also called when the edit ends.
+     * @param interval milliseconds between two calls, 0 to call the
+     * callback on each change
+     * @param isOnSettle true to call the callback once the value hasn't
+     * changed for `interval` milliseconds instead
+     */
+    void setChangeInterval(uint16_t interval, bool isOnSettle = false)
+    {
+        notifyChange(true);
+        changeInterval = interval;
+        isChangeNotifiedOnSettle = isOnSettle;
+    }
+#endif
+#ifdef ItemProgress_H
+    /**
+     * Move the progress being edited by several steps at once, e.g. by the
+     * steps an encoder turned since the last call
+     * @param steps number of steps, negative to decrement
+     */
+    void adjust(int16_t steps)
+    {
+        wake();
+        MenuItem *item = currentMenuTable[cursorPosition];
+        if (item->getType() != MENU_ITEM_PROGRESS || !isInEditMode() ||
+            !steps)
+            return;
+        adjustProgress(item, steps);
+    }
+    /**
+     * Speed up the edition of progress items when `left()`, `right()` or
+     * `adjust()` are repeated quickly in the same direction, e.g. while a
+     * button is held. The steps double every 4 repeats up to 16 times.
+     * @param interval maximum time between two repeats in milliseconds, 0
+     * to disable
+     */
+    void setAcceleration(uint16_t interval) { accelerationInterval = interval; }
+    /**
+     * Limit how often a progress is redrawn while it is edited, the
+     * postponed redraw is done by `poll()`
+     * @param interval minimum time between two redraws in milliseconds, 0
+     * to redraw each change
+     */
+    void setProgressRefreshInterval(uint16_t interval)
+    {
+        progressRefreshInterval = interval;
+    }
+#endif
+    /**
+     * Execute an "up press" on menu
+     * When edit mode is enabled, this action is skipped
+     * @return 'bool' True if up action performed
+     */
+    bool up()
+    {
+        wake();
+        uint8_t cursorLine = constrain(cursorPosition - top, 0, maxRows - 1);
+        if (checkAllAboveHidden(cursorPosition))
+        {
+            cursorLine = 0;
+        }
+        bool wasAtTop = cursorLine == 0;
+
+        if (isEditModeEnabled)
+        {
+            return false;
+        }
+        if (isAtTheStart())
+        {
+            return wrapAround(false);
+        }
+        if (checkAllAboveHidden(cursorPosition))
+        {
+            // first entry of the window of a virtual menu
+            scrollWindow(false);
+            update();
+            return true;
+        }
+        cursorPosition = previousVisibleItem(cursorPosition - 1);
+
+        if (cursorPosition < top)
+        {
+            if (wasAtTop)
+            {
+                top = cursorPosition;
+                bottom = top + maxRows - 1;
+            }
+        }
+
+        drawChanges();
+        return true;
+    }
+    /**
+     * Execute a "down press" on menu
+     * When edit mode is enabled, this action is skipped
+     * @return 'bool' True if down action performed
+     */
+    bool down()
+    {
+        wake();
+
+        uint8_t cursorLine = constrain(cursorPosition - top, 0, maxRows - 1);
+        if (checkAllBelowHidden(cursorPosition))
+        {
+            cursorLine = maxRows - 1;
+        }
+        bool wasAtBottom = cursorLine == maxRows - 1;
+
+        if (isEditModeEnabled)
+        {
+            return false;
+        }
+        if (isAtTheEnd())
+        {
+            return wrapAround(true);
+        }
+        if (checkAllBelowHidden(cursorPosition))
+        {
+            // last entry of the window of a virtual menu
+            scrollWindow(true);
+            update();
+            return true;
+        }
+        uint8_t next = nextVisibleItem(cursorPosition + 1);
+        int8_t numSkipped = next - cursorPosition - 1;
+        cursorPosition = next;
+
+        if (cursorPosition > bottom)
+        {
+            if (wasAtBottom)
+            {
+                top = cursorPosition - numSkipped - 1;
+                bottom = top + maxRows - 1;
+            }
+        }
+
+        drawChanges();
+        return true;
+    }
+    /**
+     * Move the cursor up by one page, as many visible items as there are
+     * lines. The menu is drawn once. At the first item it wraps around if
+     * `setWrapAround()` was enabled.
+     * @return 'bool' True if the cursor moved
+     */
+    bool pageUp()
+    {
+        wake();
+        if (isEditModeEnabled)
+            return false;
+        if (canScrollWindow(false) || canScrollWindow(true))
+            return moveVirtualPage(false);
+        if (isAtTheStart())
+            return wrapAround(false);
+        uint8_t index = cursorPosition;
+        for (uint8_t n = 0; n < maxRows && !checkAllAboveHidden(index); n++)
+        {
+            index = previousVisibleItem(index - 1);
+        }
+        showItem(index);
+        return true;
+    }
+    /**
+     * Move the cursor down by one page, as many visible items as there are
+     * lines. The menu is drawn once. At the last item it wraps around if
+     * `setWrapAround()` was enabled.
+     * @return 'bool' True if the cursor moved
+     */
+    bool pageDown()
+    {
+        wake();
+        if (isEditModeEnabled)
+            return false;
+        if (canScrollWindow(false) || canScrollWindow(true))
+            return moveVirtualPage(true);
+        if (isAtTheEnd())
+            return wrapAround(true);
+        uint8_t index = cursorPosition;
+        for (uint8_t n = 0; n < maxRows && !checkAllBelowHidden(index); n++)
+        {
+            index = nextVisibleItem(index + 1);
+        }
+        showItem(index);
+        return true;
+    }
+    /**
+     * Let `up()`, `down()`, `pageUp()` and `pageDown()` go from one end of
+     * the menu to the other, except in a `VirtualMenu`
+     * @param isEnabled true to wrap around
+     */
+    void setWrapAround(bool isEnabled) { isWrapAround = isEnabled; }
+    /**
+     * Scroll the text of the item at the cursor when it is longer than the
+     * line, one character per interval. Only its line is drawn again, the
+     * text starts over after its last character and after any action on
+     * the menu, it stays still in edit mode and while the display is off.
+     * `poll()` must be called from `loop()`.
+     * @param interval time between two steps in milliseconds, 0 to disable
+     */
+    void setMarquee(uint16_t interval)
+    {
+        marqueeInterval = interval;
+        if (!interval)
+            stopMarquee();
+    }
+
+    /**
+     * Execute an "enter" action on menu.
+     *
+     * It does the following depending on the type of the current menu item:
+     *
+     * - Open a sub menu.
+     * - Execute a callback action.
+     * - Toggle the state of an item.
+     */
+    void enter()
+    {
+        wake();
+        size_t pos = cursorPosition;
+        MenuItem *item = currentMenuTable[pos];
+
+        //
+        // determine the type of menu entry, then execute it
+        //
+        switch (item->getType())
+        {
+        //
+        // switch the menu to the selected sub menu
+        //
+        case MENU_ITEM_SUB_MENU:
+        {
+            enterSubMenu(item);
+            break;
+        }
+#ifdef ItemCommand_H
+        //
+        // execute the menu item's function
+        //
+        case MENU_ITEM_COMMAND:
+        {
+            //
+            // execute the menu item's function
+            //
+            fptr callback = static_cast<ItemCommand *>(item)->getCallback();
+            if (callback != NULL)
+            {
+                MENU_STAT(beginCallback());
+                callback();
+                MENU_STAT(endCallback());
+            }
+            //
+            // display the menu again
+            //
+            update();
+            break;
+        }
+#endif
+#ifdef VirtualMenu_H
+        //
+        // execute the callback of the virtual menu with the entry's index
+        //
+        case MENU_ITEM_VIRTUAL_ENTRY:
+        {
+            if (item->getCallbackInt() != NULL)
+            {
+                MENU_STAT(beginCallback());
+                (item->getCallbackInt())(item->getItemIndex());
+                MENU_STAT(endCallback());
+            }
+            update();
+            break;
+        }
+#endif
+#ifdef ItemToggle_H
+        case MENU_ITEM_TOGGLE:
+        {
+            //
+            // toggle the value of isOn
+            //
+            ItemToggle *toggle = static_cast<ItemToggle *>(item);
+            toggle->setIsOn(!toggle->isOn());
+            //
+            // execute the menu item's function
+            //
+            if (toggle->getCallbackInt() != NULL)
+            {
+                MENU_STAT(beginCallback());
+                (toggle->getCallbackInt())(toggle->isOn());
+                MENU_STAT(endCallback());
+            }
+            //
+            // display the item again
+            //
+            drawChanges();
+            break;
+        }
+#endif
+#ifdef ItemInput_H
+        case MENU_ITEM_INPUT:
+        {
+            //
+            // enter editmode
+            //
+            if (!isInEditMode())
+            {
+                isEditModeEnabled = true;
+                // blinker will be drawn
+                drawCursor();
+            }
+            break;
+        }
+#endif
+        case MENU_ITEM_PROGRESS:
+        case MENU_ITEM_LIST:
+        {
+            //
+            // execute the menu item's function
+            //
+            if (!isInEditMode())
+            {
+                isEditModeEnabled = true;
+                item->saveProgress();
+
+                drawCursor();
+            }
+            break;
+        }
+        }
+    }
+    /**
+     * Execute a "backpress" action on menu.
+     *
+     * Navigates up once, or leaves the edit mode and calls the callback of
+     * the edited item.
+     * @param editCancelled true to leave the edit mode without calling the
+     * callbacks, a list or a progress gets back its previous value
+     */
+    void back(bool editCancelled = false)
+    {
+        wake();
+        MenuItem *item = currentMenuTable[cursorPosition];
+        if (isInEditMode() && editCancelled)
+        {
+            cancelEdit();
+            drawChanges();
+            return;
+        }
+        //
+        // Back action different when on ItemInput
+        //
+        if (isInEditMode())
+        {
+            switch (item->getType())
+            {
+#ifdef ItemInput_H
+            case MENU_ITEM_INPUT:
+                // Disable edit mode
+                isEditModeEnabled = false;
+                update();
+                // Execute callback function
+                {
+                    ItemInput *input = static_cast<ItemInput *>(item);
+                    if (input->getCallbackStr() != NULL)
+                    {
+                        MENU_STAT(beginCallback());
+                        (input->getCallbackStr())(input->getValue());
+                        MENU_STAT(endCallback());
+                    }
+                }
+                // Interrupt going back to parent menu
+                return;
+#endif
+#if defined(ItemProgress_H) || defined(ItemList_H)
+            case MENU_ITEM_LIST:
+            case MENU_ITEM_PROGRESS:
+                // Disable edit mode
+                isEditModeEnabled = false;
+
+                // Call the deferred change callback
+                notifyChange(true);
+
+                // Execute callback function
+                if (item->getCallbackInt() != NULL)
+                {
+                    MENU_STAT(beginCallback());
+                    (item->getCallbackInt())(item->getItemIndex());
+                    MENU_STAT(endCallback());
+                }
+                // Interrupt going back to parent menu
+
+                update();
+                return;
+#endif
+            default:
+                break;
+            }
+        }
+        //
+        // check if this is a sub menu, if so go back to its parent
+        //
+        if (isSubMenu())
+        {
+            leaveSubMenu();
+        }
+    }
+    /**
+     * Go back to the main menu from any sub menu, at the position it was
+     * left. A value being edited is cancelled.
+     */
+    void home()
+    {
+        wake();
+        if (isInEditMode())
+        {
+            cancelEdit();
+            if (currentMenuTable == rootMenu)
+            {
+                drawChanges();
+                return;
+            }
+        }
+        if (currentMenuTable == rootMenu)
+            return;
+        //
+        // the first frame is the main menu unless it was dropped from a full
+        // stack
+        //
+        if (navigationDepth && navigationStack[0].menu == rootMenu)
+            restoreFrame(navigationStack[0]);
+        else
+            setCurrentMenu(rootMenu, getMenuSize(rootMenu), 1, maxRows, 1);
+        navigationDepth = 0;
+        update();
+    }
+    /**
+     * Move the cursor to the next visible item whose text starts with a
+     * character, ignoring the case. The search starts after the cursor and
+     * wraps around the menu, calling it again with the same character goes
+     * through all the matching items. The menu is drawn once.
+     *
+     * Does nothing in edit mode, use `type()` to edit an input.
+     * @param character first character of the item
+     * @return `bool` - true if an item was found
+     */
+    bool jumpTo(char character)
+    {
+        wake();
+        if (isEditModeEnabled)
+            return false;
+        updateVisibleItems();
+        uint8_t letter = toupper(character);
+        //
+        // the items between the header and the footer, a menu has at most
+        // 255 items with them
+        //
+        uint8_t count = currentMenuSize - 2;
+        for (uint16_t n = 1; n <= count; n++)
+        {
+            uint8_t i = (cursorPosition - 1 + n) % count + 1;
+            if (readItemLetter(currentMenuTable[i]) != letter ||
+                !isItemVisible(i))
+                continue;
+            if (i == cursorPosition)
+                return true;
+            //
+            // keep the window if the item is on it at the line of its
+            // position, otherwise move the window like wrapAround()
+            //
+            if (i >= top && i <= bottom && countVisibleItems(top, i) == i - top)
+            {
+                cursorPosition = i;
+                drawChanges();
+            }
+            else
+            {
+                showItem(i);
+            }
+            return true;
+        }
+        return false;
+    }
+    /**
+     * Go straight to an item, the menu is drawn once.
+     *
+     * Each index of the path but the last is the index of a sub menu item
+     * to enter, starting from the main menu, the last one is the index of
+     * the item to put the cursor on. The indexes are those of
+     * `getCursorPosition()`, the first item of a menu is 1. `back()` then
+     * goes through the menus of the path. A value being edited is
+     * cancelled.
+     *
+     * **Example**
+     *
+     * ```cpp
+     * const uint8_t wifi[] = {2, 3, 1};  // Settings > Network > WiFi
+     * menu.navigateTo(wifi, 3);
+     * ```
+     *
+     * @param path index of the item in each level
+     * @param length number of levels, at most `LCD_MENU_MAX_DEPTH + 1`
+     * @return `bool` - false if the path doesn't lead to a visible item, the
+     * menu is then left as it was
+     */
+    bool navigateTo(const uint8_t *path, uint8_t length)
+    {
+        if (length == 0 || length > LCD_MENU_MAX_DEPTH + 1)
+            return false;
+        //
+        // check the whole path before changing anything
+        //
+        MenuItem **menu = rootMenu;
+        for (uint8_t i = 0; i < length; i++)
+        {
+            if (path[i] < 1 || path[i] >= getMenuSize(menu) - 1 ||
+                menu[path[i]]->isHidden())
+                return false;
+            if (i == length - 1)
+                break;
+            if (menu[path[i]]->getType() != MENU_ITEM_SUB_MENU ||
+                menu[path[i]]->getSubMenu() == NULL)
+                return false;
+            menu = menu[path[i]]->getSubMenu();
+        }
+        wake();
+        if (isInEditMode())
+            cancelEdit();
+        //
+        // the menus of the path are pushed as if they had been entered, each
+        // one is made current to place its cursor past its hidden items
+        //
+        menu = rootMenu;
+        for (uint8_t i = 0; i < length; i++)
+        {
+            setCurrentMenu(menu, getMenuSize(menu), 1, maxRows, 1);
+            placeCursor(path[i]);
+            if (i == length - 1)
+                break;
+            navigationStack[i] = {menu, (uint8_t)currentMenuSize, top, bottom,
+                                  cursorPosition};
+            menu = menu[path[i]]->getSubMenu();
+        }
+        navigationDepth = length - 1;
+        update();
+        return true;
+    }
+    /**
+     * Go straight to an item of a menu, the menu is drawn once. The menu is
+     * looked for from the main menu, a sub menu reached from several menus
+     * is entered through the first one.
+     *
+     * **Example**
+     *
+     * ```cpp
+     * menu.navigateTo(networkMenu, 1);
+     * ```
+     *
+     * @param menu menu to show
+     * @param index index of the item to put the cursor on, the first item is
+     * 1
+     * @return `bool` - false if the menu isn't reachable from the main menu
+     * within `LCD_MENU_MAX_DEPTH` levels or the item isn't visible
+     */
+    bool navigateTo(MenuItem **menu, uint8_t index)
+    {
+        uint8_t path[LCD_MENU_MAX_DEPTH + 1];
+        uint8_t length = 0;
+        if (menu != rootMenu)
+        {
+            length = findPath(rootMenu, menu, path, 0);
+            if (!length)
+                return false;
+        }
+        path[length] = index;
+        return navigateTo(path, length + 1);
+    }
+    /**
+     * Execute a "left press" on menu
+     *
+     * *NB: Works only for `ItemInput` and `ItemList` types*
+     *
+     * Moves the cursor one step to the left.
+     */
+    void left()
+    {
+        wake();
+        //
+        if (isInEditMode() && isCharPickerActive)
+            return;
+        //
+        MenuItem *item = currentMenuTable[cursorPosition];
+        //
+        // get the type of the currently displayed menu
+        //
+#ifdef ItemList_H
+        uint8_t previousIndex = item->getItemIndex();
+#endif
+        switch (item->getType())
+        {
+#ifdef ItemList_H
+        case MENU_ITEM_LIST:
+        {
+            ItemList *list = static_cast<ItemList *>(item);
+            uint16_t version = beginChange(item);
+            list->setItemIndex(list->getItemIndex() - 1);
+            endChange(item, version);
+            if (previousIndex != item->getItemIndex())
+                drawChanges();
+            break;
+        }
+#endif
+#ifdef ItemInput_H
+        case MENU_ITEM_INPUT:
+        {
+            blinkerPosition--;
+            resetBlinker();
+            break;
+        }
+#endif
+#ifdef ItemProgress_H
+        case MENU_ITEM_PROGRESS:
+        {
+            if (isInEditMode())
+            {
+                adjustProgress(item, -1);
+            }
+        }
+#endif
+        }
+    }
+    /**
+     * Execute a "right press" on menu
+     *
+     * *NB: Works only for `ItemInput` and `ItemList` types*
+     *
+     * Moves the cursor one step to the right.
+     */
+    void right()
+    {
+        wake();
+        //
+        // Is the menu in edit mode and is the character picker active?
+        //
+        if (isInEditMode() && isCharPickerActive)
+            return;
+        //
+        MenuItem *item = currentMenuTable[cursorPosition];
+        //
+        // get the type of the currently displayed menu
+        //
+        switch (item->getType())
+        {
+#ifdef ItemList_H
+        case MENU_ITEM_LIST:
+        {
+            ItemList *list = static_cast<ItemList *>(item);
+            uint16_t version = beginChange(item);
+            list->setItemIndex((list->getItemIndex() + 1) %
+                               list->getItemCount());
+            endChange(item, version);
+            // constrain(item->itemIndex + 1, 0, item->itemCount - 1);
+            drawChanges();
+            break;
+        }
+#endif
+#ifdef ItemInput_H
+        case MENU_ITEM_INPUT:
+        {
+            blinkerPosition++;
+            resetBlinker();
+            break;
+        }
+#endif
+#ifdef ItemProgress_H
+        case MENU_ITEM_PROGRESS:
+        {
+            if (isInEditMode())
+            {
+                adjustProgress(item, 1);
+            }
+            break;
+        }
+#endif
+        }
+    }
+#ifdef ItemInput_H
+    /**
+     * Execute a "backspace cmd" on menu
+     *
+     * *NB: Works only for `ItemInput` type*
+     *
+     * Removes the character at the current cursor position.
+     */
+    void backspace()
+    {
+        wake();
+        MenuItem *item = currentMenuTable[cursorPosition];
+        //
+        if (item->getType() != MENU_ITEM_INPUT)
+            return;
+        //
+        uint8_t lb = getTextLength(item) + 2;
+        if (blinkerPosition <= lb ||
+            !static_cast<ItemInput *>(item)->removeChar(blinkerPosition - lb -
+                                                        1))
+            return;
+
+        blinkerPosition--;
+        drawChanges();
+    }
+    /**
+     * Display text at the cursor position
+     * used for `Input` type menu items
+     * @param character character to append
+     */
+    void type(char character) { editValue(character, false); }
+    /**
+     * Insert a character at the cursor position
+     * used for `Input` type menu items
+     * @param character character to insert
+     */
+    void insert(char character) { editValue(character, true); }
+    /**
+     * Draw a character on the display
+     * used for `Input` type menu items.
+     * @param c character to draw
+     */
+    void drawChar(char c)
+    {
+        wake();
+        MenuItem *item = currentMenuTable[cursorPosition];
+        //
+        if (item->getType() != MENU_ITEM_INPUT || !isEditModeEnabled)
+            return;
+        //
+        // draw the character without updating the menu item
+        //
+        uint8_t line = constrain(cursorPosition - top, 0, maxRows - 1);
+        buffer[line][blinkerPosition] = c;
+        rowItems[line] = NULL;
+        if (isRenderDeferred())
+        {
+            isFrameDirty = true;
+            isBlinkerDirty = true;
+        }
+        else
+        {
+            flush();
+            resetBlinker();
+        }
+        //
+        isCharPickerActive = true;
+    }
+    /**
+     * Clear the value of the input field
+     */
+    void clear()
+    {
+        wake();
+        MenuItem *item = currentMenuTable[cursorPosition];
+        //
+        if (item->getType() != MENU_ITEM_INPUT)
+            return;
+        //
+        // set the value
+        //
+        static_cast<ItemInput *>(item)->setValue((char *)"");
+        //
+        // update blinker position
+        //
+        blinkerPosition = 0;
+        //
+        // repaint item
+        //
+        drawChanges();
+    }
+#endif
+    /**
+     * Set the character used to visualize the cursor.
+     * @param newIcon character to use for default cursor
+     * @param newEditIcon character use for edit mode cursor
+     */
+    void setCursorIcon(uint8_t newIcon, uint8_t newEditIcon)
+    {
+        cursorIcon = newIcon;
+        editCursorIcon = newEditIcon;
+        drawCursor();
+    }
+    /**
+     * Reserve characters of the CGRAM of the display for custom characters,
+     * so they are not used by the menu. The arrows use the first two and the
+     * progress bars four more when one is drawn.
+     *
+     * **Example**
+     *
+     * ```cpp
+     * int8_t slot = menu.reserveGlyphs(1);
+     * lcd.createChar(slot, heart);
+     * ```
+     *
+     * @param count number of consecutive characters
+     * @return `int8_t` - first character reserved, -1 if there are not
+     * enough free characters
+     */
+    int8_t reserveGlyphs(uint8_t count)
+    {
+        uint8_t mask = (1 << count) - 1;
+        for (uint8_t slot = 0; count && slot + count <= 8; slot++)
+        {
+            if (!(usedGlyphs & (mask << slot)))
+            {
+                usedGlyphs |= mask << slot;
+                return slot;
+            }
+        }
+        return -1;
+    }
+    /**
+     * When you want to display any other content on the screen then
+     * call this function then display your content, later call
+     * `show()` to show the menu
+     */
+    void hide()
+    {
+        enableUpdate = false;
+        lcd->clear();
+        drawnMenuTable = NULL;
+        isScreenInvalid = true;
+        flushLine = 0;
+        flushCol = 0;
+        isFrameDirty = false;
+        lcdLine = 255;
+    }
+    /**
+     * Show the menu
+     */
+    void show()
+    {
+        wake();
+        enableUpdate = true;
+        resetRowCache();
+        update();
+    }
+    /**
+     * To know weather the menu is in edit mode or not
+     * @return `bool` - isEditModeEnabled
+     */
+    bool isInEditMode() { return isEditModeEnabled; }
+    /**
+     * Get the current cursor position
+     * @return `cursorPosition` e.g. 1, 2, 3...
+     */
+    uint8_t getCursorPosition() { return this->cursorPosition; }
+    /**
+     * Get the number of rows the menu is drawn on
+     * @return `maxRows` e.g. 2, 4
+     */
+    uint8_t getMaxRows() { return maxRows; }
+    /**
+     * Get the number of columns the menu is drawn on
+     * @return `maxCols` e.g. 16, 20
+     */
+    uint8_t getMaxCols() { return maxCols; }
+    /**
+     * Set the current cursor position
+     * @param position
+     */
+    void setCursorPosition(uint8_t position)
+    {
+        this->cursorPosition = position;
+    }
+    /**
+     * Update timer and turn off display on timeout, call it in `loop()`.
+     * The backlight is dimmed first if `setDimTimeout()` was called, the
+     * commands are only sent once per state.
+     */
+    void updateTimer()
+    {
+        // the subtraction stays correct when millis() overflows
+        unsigned long elapsed = millis() - startTime;
+        if (powerState != POWER_OFF && elapsed >= timeout)
+        {
+            lcd->noDisplay();
+            lcd->noBacklight();
+            powerState = POWER_OFF;
+        }
+        else if (powerState == POWER_ON && dimTimeout && elapsed >= dimTimeout)
+        {
+            lcd->setBacklight(dimBacklight);
+            powerState = POWER_DIMMED;
+        }
+    }
+    /**
+     * Restart the timeout and switch the display back on if it was dimmed
+     * or turned off, the actions on the menu call it. What was drawn while
+     * the display was off is sent once. The marquee starts over from the
+     * beginning of the text.
+     */
+    void wake()
+    {
+        stopMarquee();
+        startTime = millis();
+        if (powerState == POWER_ON)
+            return;
+        if (powerState == POWER_OFF)
+            lcd->display();
+        lcd->setBacklight(backlightState);
+        powerState = POWER_ON;
+        if (isFrameDirty && enableUpdate && !isRenderSliced())
+        {
+            flush();
+            isFrameDirty = false;
+            if (isBlinkerDirty)
+            {
+                isBlinkerDirty = false;
+                drawBlinker();
+            }
+        }
+    }
+    /**
+     * Dim the backlight before switching the display off
+     * @param timeout time without action before dimming in milliseconds,
+     * shorter than `timeout`, 0 to disable
+     * @param backlight backlight while dimmed, e.g. `LOW` for displays
+     * whose backlight can only be on or off
+     */
+    void setDimTimeout(uint16_t timeout, uint8_t backlight = LOW)
+    {
+        dimTimeout = timeout;
+        dimBacklight = backlight;
+    }
+    /**
+     * Check if the display was switched off by the timeout
+     * @return `bool` - true until the next action on the menu
+     */
+    bool isAsleep() { return powerState == POWER_OFF; }
+#ifdef ENABLE_MENU_STATS
+    /**
+     * Get the counters of what the menu did since the last `resetStats()`
+     * @return `MenuStats` - the counters
+     */
+    const MenuStats &getStats() { return stats; }
+    /**
+     * Set all the counters to 0
+     */
+    void resetStats() { stats = MenuStats(); }
+#endif
+    /**
+     * Check if currently displayed menu is a sub menu.
+     */
+    bool isSubMenu()
+    {
+        byte menuItemType = currentMenuTable[0]->getType();
+        return navigationDepth || menuItemType == MENU_ITEM_SUB_MENU_HEADER ||
+               menuItemType == MENU_ITEM_VIRTUAL_MENU;
+    }
+
+    /**
+     * Get the number of items in a menu, header and footer included.
+     * The size is given by the menu macros, for other menus it is counted
+     * once and remembered by the header.
+     * @param menu menu to measure
+     * @return `size_t` - number of items in `menu`
+     */
+    size_t getMenuSize(MenuItem **menu)
+    {
+#ifdef VirtualMenu_H
+        //
+        // the window of a virtual menu is as high as the display
+        //
+        if (menu[0]->getType() == MENU_ITEM_VIRTUAL_MENU)
+            static_cast<VirtualMenu *>(menu[0])->setRows(maxRows);
+#endif
+        size_t s = menu[0]->getMenuSize();
+        if (s)
+        {
+            return s;
+        }
+
+        while (menu[s]->getType() != MENU_ITEM_END_OF_MENU)
+        {
+            s++;
+        }
+        s++;
+        menu[0]->setMenuSize(s);
+        return s;
+    }
+
+    /**
+     * Get a `MenuItem` at position
+     * @return `MenuItem` - item at `position`
+     */
+    MenuItem *getItemAt(uint8_t position) { return currentMenuTable[position]; }
+    /**
+     * Get a `MenuItem` at position using operator function
+     * e.g `menu[menu.getCursorPosition()]` will return the item at the
+     * current cursor position NB: This is relative positioning (i.e. if a
+     * submenu is currently being displayed, menu[1] will return item 1 in
+     * the current menu)
+     * @return `MenuItem` - item at `position`
+     */
+    MenuItem *operator[](const uint8_t position)
+    {
+        return currentMenuTable[position];
+    }
+    /**
+     * Set the Backlight state
+     * @param state
+     */
+    void setBacklight(uint8_t state)
+    {
+        backlightState = state;
+        if (powerState == POWER_ON)
+            lcd->setBacklight(state);
+        update();
+    }
+};
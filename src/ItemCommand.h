@@ -15,10 +15,10 @@
 #include "MenuItem.h"
 
 // Declare a class for menu items that represent commands.
-class ItemCommand : public MenuItem {
+class ItemCommand final : public MenuItem {
    private:
     // Declare a function pointer for the command callback.
-    fptr callback;
+    fptr callback = NULL;
 
    public:
     /**
@@ -28,17 +28,15 @@ class ItemCommand : public MenuItem {
      * @param callback A reference to the callback function to be invoked when
      * the item is entered.
      */
-    ItemCommand(const char* key, fptr callback)
-        : MenuItem(key, MENU_ITEM_COMMAND) {
-        this->callback = callback;
-    }
+    constexpr ItemCommand(MenuText key, fptr callback)
+        : MenuItem(key, MENU_ITEM_COMMAND), callback(callback) {}
 
     /**
      * Get the callback function for this item.
      *
      * @return The function pointer to the callback function.
      */
-    fptr getCallback() override { return callback; }
+    fptr getCallback() { return callback; }
 
     /**
      * Set the callback function for this item.
@@ -46,9 +44,19 @@ class ItemCommand : public MenuItem {
      * @param callback A reference to the new callback function to be invoked
      * when the item is entered.
      */
-    void setCallBack(fptr callback) override { this->callback = callback; };
+    void setCallBack(fptr callback) { this->callback = callback; };
 };
 
+inline fptr MenuItem::getCallback() {
+    return type == MENU_ITEM_COMMAND
+               ? static_cast<ItemCommand*>(this)->getCallback()
+               : NULL;
+}
+inline void MenuItem::setCallBack(fptr callback) {
+    if (type == MENU_ITEM_COMMAND)
+        static_cast<ItemCommand*>(this)->setCallBack(callback);
+}
+
 #define ITEM_COMMAND(...) (new ItemCommand(__VA_ARGS__))
 
 #endif  // ITEM_COMMAND_H
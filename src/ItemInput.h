@@ -5,7 +5,9 @@
  *
  * This is an item type where a user can type in information,
  * the information is persisted in the item and can be gotten later by
- * using `item->value`
+ * using `item->value`. The value is edited in place in the buffer given to
+ * the item, `ITEM_INPUT()` without a buffer gives the item one of
+ * `ITEM_INPUT_CAPACITY` characters.
  */
 
 #ifndef ItemInput_H
@@ -14,36 +16,47 @@
 // Include the header file for the base class.
 #include "MenuItem.h"
 
+// Size of the buffer of an input created without one, the value is at most
+// `ITEM_INPUT_CAPACITY - 1` characters long.
+#ifndef ITEM_INPUT_CAPACITY
+#define ITEM_INPUT_CAPACITY 17
+#endif
+
 // Declare a class for menu items that allow the user to input information.
 class ItemInput : public MenuItem {
    private:
     // Declare a string to hold the input value.
     char* value;
 
+    // Size of the buffer holding the value, 0 if the item doesn't own it.
+    uint8_t capacity = 0;
+
+    // Check if the value is in a buffer that can be edited.
+    bool isEditable() const { return value != NULL && capacity; }
+
     // Declare a function pointer for the input callback.
     fptrStr callback;
 
    public:
     /**
-     * Construct a new ItemInput object with an initial value.
+     * Construct a new ItemInput object that edits a buffer in place.
      *
-     * @param text The text to display for the item.
-     * @param value The initial value for the input.
-     * @param callback A reference to the callback function to be invoked when
-     * the input is submitted.
-     */
-    ItemInput(const char* text, char* value, fptrStr callback)
-        : MenuItem(text, MENU_ITEM_INPUT), value(value), callback(callback) {}
-
-    /**
-     * Construct a new ItemInput object with no initial value.
+     * The typed characters are written straight into `buffer`, nothing is
+     * allocated while editing.
      *
      * @param text The text to display for the item.
+     * @param buffer The buffer holding the value, it must hold a string.
+     * @param capacity The size of `buffer`, the value is at most
+     * `capacity - 1` characters long.
      * @param callback A reference to the callback function to be invoked when
      * the input is submitted.
      */
-    ItemInput(const char* text, fptrStr callback)
-        : ItemInput(text, (char*)"", callback) {}
+    constexpr ItemInput(MenuText text, char* buffer, uint8_t capacity,
+                        fptrStr callback)
+        : MenuItem(text, MENU_ITEM_INPUT),
+          value(buffer),
+          capacity(capacity),
+          callback(callback) {}
 
     /**
      * Get the current input value for this item.
@@ -57,16 +70,151 @@ class ItemInput : public MenuItem {
      *
      * @param value The new input value.
      */
-    void setValue(char* value) override { this->value = value; }
+    void setValue(char* value) {
+        if (isEditable()) {
+            // copy into the buffer of the item
+            strncpy(this->value, value, capacity - 1);
+            this->value[capacity - 1] = '\0';
+        } else {
+            this->value = value;
+        }
+        markChanged();
+    }
+
+    /**
+     * Get the size of the buffer holding the value.
+     *
+     * @return The size of the buffer, 0 if the item doesn't own it.
+     */
+    uint8_t getCapacity() const { return capacity; }
+
+    /**
+     * Move the value into a buffer owned by the item, it is truncated to
+     * `capacity - 1` characters.
+     *
+     * @param buffer The new buffer, ignored if `NULL`.
+     * @param capacity The size of `buffer`, ignored if 0.
+     */
+    void setBuffer(char* buffer, uint8_t capacity) {
+        if (buffer == NULL || capacity == 0) return;
+        strncpy(buffer, value != NULL ? value : "", capacity - 1);
+        buffer[capacity - 1] = '\0';
+        this->value = buffer;
+        this->capacity = capacity;
+        markChanged();
+    }
+
+    /**
+     * Insert a character in the value.
+     *
+     * @param index The position of the character, at most the length of the
+     * value.
+     * @param c The character to insert.
+     * @return true if the character was inserted, false if the buffer is full.
+     */
+    bool insertChar(uint8_t index, char c) {
+        if (!isEditable()) return false;
+        uint8_t length = strlen(value);
+        if (index > length || length + 1 >= capacity) return false;
+        memmove(value + index + 1, value + index, length - index + 1);
+        value[index] = c;
+        markChanged();
+        return true;
+    }
+
+    /**
+     * Overwrite a character of the value, the character is appended when
+     * `index` is the length of the value.
+     *
+     * @param index The position of the character.
+     * @param c The new character.
+     * @return true if the value changed.
+     */
+    bool replaceChar(uint8_t index, char c) {
+        if (!isEditable()) return false;
+        uint8_t length = strlen(value);
+        if (index >= length) return insertChar(index, c);
+        value[index] = c;
+        markChanged();
+        return true;
+    }
+
+    /**
+     * Remove a character from the value.
+     *
+     * @param index The position of the character.
+     * @return true if the character was removed.
+     */
+    bool removeChar(uint8_t index) {
+        if (!isEditable()) return false;
+        uint8_t length = strlen(value);
+        if (index >= length) return false;
+        memmove(value + index, value + index + 1, length - index);
+        markChanged();
+        return true;
+    }
 
     /**
      * Get the callback function for this item.
      *
      * @return The function pointer to the callback function.
      */
-    fptrStr getCallbackStr() override { return callback; }
+    fptrStr getCallbackStr() { return callback; }
+};
+
+inline fptrStr MenuItem::getCallbackStr() {
+    return type == MENU_ITEM_INPUT
+               ? static_cast<ItemInput*>(this)->getCallbackStr()
+               : NULL;
+}
+inline void MenuItem::setValue(char* value) {
+    if (type == MENU_ITEM_INPUT) static_cast<ItemInput*>(this)->setValue(value);
+}
+
+/**
+ * An input editing a buffer of `Capacity` characters held by the item, for
+ * the inputs created without a buffer.
+ */
+template <uint8_t Capacity = ITEM_INPUT_CAPACITY>
+class ItemInputBuffer final : public ItemInput {
+   private:
+    char buffer[Capacity];
+
+   public:
+    /**
+     * Construct a new ItemInput object with an initial value.
+     *
+     * @param text The text to display for the item.
+     * @param value The initial value for the input, it is copied and
+     * truncated to `Capacity - 1` characters.
+     * @param callback A reference to the callback function to be invoked when
+     * the input is submitted.
+     */
+    ItemInputBuffer(MenuText text, const char* value, fptrStr callback)
+        : ItemInput(text, buffer, Capacity, callback) {
+        strncpy(buffer, value != NULL ? value : "", Capacity - 1);
+        buffer[Capacity - 1] = '\0';
+    }
+
+    /**
+     * Construct a new ItemInput object with no initial value.
+     *
+     * @param text The text to display for the item.
+     * @param callback A reference to the callback function to be invoked when
+     * the input is submitted.
+     */
+    ItemInputBuffer(MenuText text, fptrStr callback)
+        : ItemInputBuffer(text, "", callback) {}
 };
 
-#define ITEM_INPUT(...) (new ItemInput(__VA_ARGS__))
+//
+// ITEM_INPUT(text, buffer, capacity, callback) edits the given buffer,
+// ITEM_INPUT(text, callback) and ITEM_INPUT(text, value, callback) get a
+// buffer of their own
+//
+#define ITEM_INPUT_SELECT(_1, _2, _3, _4, NAME, ...) NAME
+#define ITEM_INPUT(...)                                                \
+    (new ITEM_INPUT_SELECT(__VA_ARGS__, ItemInput, ItemInputBuffer<>, \
+                           ItemInputBuffer<>, )(__VA_ARGS__))
 
 #endif  // ITEM_INPUT_H
@@ -27,12 +27,13 @@
 #define ItemList_H
 #include "MenuItem.h"
 
-class ItemList : public MenuItem
+class ItemList final : public ItemValue
 {
 private:
     fptrInt callback = NULL; ///< Pointer to a callback function
-    fptrInt changeCallback = NULL;
     String *items = NULL;          ///< Pointer to an array of items
+    const char *const *texts = NULL; ///< Pointer to an array of texts
+    bool textsInFlash = false;     ///< Whether `texts` is in flash memory
     const uint8_t itemCount;       ///< The total number of items in the list
     uint16_t itemIndex = 0;        ///< The current selected item index
     uint16_t initialItemIndex = 0; ///< Initial index, before edit starts
@@ -46,22 +47,46 @@ public:
      * @param callback A pointer to the callback function to execute when
      * this menu item is selected.
      */
-    ItemList(const char *key, String *items, const uint8_t itemCount,
-             fptrInt callback)
-        : MenuItem(key, MENU_ITEM_LIST), itemCount(itemCount)
-    {
-        this->callback = callback;
-        this->items = items;
-    }
+    constexpr ItemList(MenuText key, String *items, const uint8_t itemCount,
+                       fptrInt callback)
+        : ItemValue(key, MENU_ITEM_LIST, NULL),
+          callback(callback),
+          items(items),
+          itemCount(itemCount) {}
 
-    ItemList(const char *key, String *items, const uint8_t itemCount,
-             fptrInt changeCallback, fptrInt callback)
-        : MenuItem(key, MENU_ITEM_LIST), itemCount(itemCount)
-    {
-        this->callback = callback;
-        this->changeCallback = changeCallback;
-        this->items = items;
-    }
+    constexpr ItemList(MenuText key, String *items, const uint8_t itemCount,
+                       fptrInt changeCallback, fptrInt callback)
+        : ItemValue(key, MENU_ITEM_LIST, changeCallback),
+          callback(callback),
+          items(items),
+          itemCount(itemCount) {}
+
+    /**
+     * @brief Constructs a new ItemList object from an array of texts.
+     *
+     * @param key The key of the menu item.
+     * @param texts The array of texts to display, use `FLASH_TEXT_LIST()`
+     * if the array is stored in flash memory.
+     * @param itemCount The number of texts in the array.
+     * @param callback A pointer to the callback function to execute when
+     * this menu item is selected.
+     */
+    constexpr ItemList(MenuText key, MenuTextList texts,
+                       const uint8_t itemCount, fptrInt callback)
+        : ItemValue(key, MENU_ITEM_LIST, NULL),
+          callback(callback),
+          texts(texts.texts),
+          textsInFlash(texts.isInFlash),
+          itemCount(itemCount) {}
+
+    constexpr ItemList(MenuText key, MenuTextList texts,
+                       const uint8_t itemCount, fptrInt changeCallback,
+                       fptrInt callback)
+        : ItemValue(key, MENU_ITEM_LIST, changeCallback),
+          callback(callback),
+          texts(texts.texts),
+          textsInFlash(texts.isInFlash),
+          itemCount(itemCount) {}
 
     /**
      * @brief Returns the index of the currently selected item.
@@ -76,6 +101,7 @@ public:
     void restoreProgress()
     {
         itemIndex = initialItemIndex;
+        markChanged();
     }
 
     /**
@@ -83,14 +109,14 @@ public:
      *
      * @return The index of the item to be selected.
      */
-    void setItemIndex(uint16_t itemIndex) override
+    void setItemIndex(uint16_t itemIndex)
     {
-        this->itemIndex = constrain(itemIndex, 0, itemCount - 1);
-
-        if (this->changeCallback)
-        {
-            this->changeCallback(this->itemIndex);
-        }
+        itemIndex = constrain(itemIndex, 0, itemCount - 1);
+        if (itemIndex == this->itemIndex)
+            return;
+        this->itemIndex = itemIndex;
+        markChanged();
+        notifyChange(changeCallback, this->itemIndex);
     }
 
     /**
@@ -105,18 +131,53 @@ public:
      *
      * @return The total number of items in the list.
      */
-    uint8_t getItemCount() override { return itemCount; };
+    uint8_t getItemCount() { return itemCount; };
 
     /**
      * @brief Returns a pointer to the array of items.
      *
      * @return A pointer to the array of items.
      */
-    String *getItems() override { return items; }
+    String *getItems() { return items; }
+
+    /**
+     * @brief Returns the text of an item without copying it.
+     *
+     * @param index The index of the item.
+     * @return The text of the item at `index`.
+     */
+    MenuText getItemText(uint16_t index)
+    {
+        if (items != NULL)
+        {
+            return MenuText(items[index].c_str());
+        }
+        if (textsInFlash)
+        {
+            return FLASH_TEXT((const char *)pgm_read_ptr(&texts[index]));
+        }
+        return MenuText(texts[index]);
+    }
 
     void saveProgress() { initialItemIndex = itemIndex; }
 };
 
+inline uint8_t MenuItem::getItemCount()
+{
+    return type == MENU_ITEM_LIST ? static_cast<ItemList *>(this)->getItemCount()
+                                  : 0;
+}
+inline String *MenuItem::getItems()
+{
+    return type == MENU_ITEM_LIST ? static_cast<ItemList *>(this)->getItems()
+                                  : NULL;
+}
+inline void MenuItem::setItemIndex(uint16_t itemIndex)
+{
+    if (type == MENU_ITEM_LIST)
+        static_cast<ItemList *>(this)->setItemIndex(itemIndex);
+}
+
 #define ITEM_STRING_LIST(...) (new ItemList(__VA_ARGS__))
 
 #endif
\ No newline at end of file
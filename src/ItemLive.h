@@ -0,0 +1,106 @@
+/**
+ * ---
+ *
+ * # ItemLive
+ *
+ * An item showing a value that changes on its own, e.g. the reading of a
+ * sensor. The value is read from a callback at most once per interval while
+ * the item is on the display and only its line is drawn again when it
+ * changes, `poll()` must be called from `loop()`.
+ *
+ * **Example**
+ *
+ * ```cpp
+ * char *temperature() {
+ *     static char text[8];
+ *     itoa(readTemperature(), text, 10);
+ *     return text;
+ * }
+ *
+ * MAIN_MENU(ITEM_LIVE("Temp", temperature, 500));
+ * ```
+ */
+
+#ifndef ItemLive_H
+#define ItemLive_H
+#include "MenuItem.h"
+
+class ItemLive final : public MenuItem
+{
+private:
+    fptrValue provider = NULL;
+    char *value = NULL;
+    uint16_t interval = 0;
+    /**
+     * Text of the previous value, only the characters a line can show
+     */
+    char lastValue[LCD_MAX_COLS + 1];
+    unsigned long lastRefreshTime = 0;
+
+public:
+    /**
+     * @param key key of the item
+     * @param provider returns the text of the value, it can reuse the same
+     * buffer every time
+     * @param interval shortest time between two reads in milliseconds
+     */
+    constexpr ItemLive(MenuText key, fptrValue provider, uint16_t interval)
+        : MenuItem(key, MENU_ITEM_LIVE), provider(provider),
+          interval(interval), lastValue() {}
+
+    /**
+     * Get the value read by the last refresh, it is read the first time
+     * @return `char*` - text of the value
+     */
+    char *getValue() override
+    {
+        if (value == NULL)
+            refresh();
+        return value != NULL ? value : (char *)"";
+    }
+    /**
+     * Shortest time between two reads of the value
+     * @return `uint16_t` - interval in milliseconds
+     */
+    uint16_t getInterval() const { return interval; }
+    /**
+     * @param interval shortest time between two reads in milliseconds
+     */
+    void setInterval(uint16_t interval) { this->interval = interval; }
+    /**
+     * Check if the value can be read again
+     * @param now current time from `millis()`
+     * @return `bool` - true if the interval has elapsed since the last read
+     */
+    bool isDue(unsigned long now) const
+    {
+        return now - lastRefreshTime >= interval;
+    }
+    /**
+     * Read the value, the version of the item only changes when its text
+     * is different from the previous one
+     * @return `bool` - true if the value changed
+     */
+    bool refresh()
+    {
+        lastRefreshTime = millis();
+        if (provider == NULL)
+            return false;
+        bool isFirstRead = value == NULL;
+        value = provider();
+        if (value == NULL)
+            value = (char *)"";
+        //
+        // compare with a copy of the text, the buffer may be the same
+        //
+        if (!isFirstRead && strncmp(value, lastValue, LCD_MAX_COLS) == 0)
+            return false;
+        strncpy(lastValue, value, LCD_MAX_COLS);
+        markChanged();
+        return true;
+    }
+};
+
+#define ITEM_LIVE(...) (new ItemLive(__VA_ARGS__))
+
+#endif
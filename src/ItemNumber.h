@@ -0,0 +1,188 @@
+/**
+ * ---
+ *
+ * # ItemNumber
+ *
+ * A number edited with `left()` and `right()` like an `ItemProgress`, the
+ * value is stored in fixed point and formatted without floating point math.
+ * The range, step and number of decimals are template parameters so they
+ * are known at compile time.
+ *
+ * **Example**
+ *
+ * ```cpp
+ * // -1.00 to 1.00 by steps of 0.05, the value is stored in hundredths
+ * ItemNumber<int16_t, -100, 100, 5, 2> current("Curr", 0, currentCallback);
+ *
+ * MAIN_MENU(&current);
+ * ```
+ *
+ * The callbacks receive the stored value, cast it back to the type of the
+ * item e.g. `(int16_t)value`.
+ */
+
+#ifndef ItemNumber_H
+#define ItemNumber_H
+#include "MenuItem.h"
+// Numbers are edited by the menu the same way as progress items
+#include "ItemProgress.h"
+
+/**
+ * @tparam T type of the stored value, 8 or 16 bits
+ * @tparam Min minimum stored value
+ * @tparam Max maximum stored value
+ * @tparam Step increment of the stored value for each step
+ * @tparam Decimals number of digits after the decimal point, e.g. 2 to show
+ * the stored value 125 as 1.25
+ */
+template <typename T, T Min, T Max, T Step = 1, uint8_t Decimals = 0>
+class ItemNumber final : public ItemValue
+{
+    static_assert(sizeof(T) <= 2, "the value must be 8 or 16 bits");
+    static_assert(Min < Max, "the range must not be empty");
+    static_assert(Step > 0, "the step must be positive");
+    static_assert(Decimals <= 4, "at most 4 decimals are supported");
+
+private:
+    fptrInt callback = NULL;       ///< Pointer to a callback function
+    T value;                       ///< The value in fixed point
+    T initialValue;                ///< Value before edit started
+    uint8_t barCells = 0;          ///< Cells of the bar, 0 to show the value
+
+    /**
+     * Keep a value in the range of the item
+     */
+    static constexpr T constrainValue(T value)
+    {
+        return value < Min ? Min : value > Max ? Max : value;
+    }
+
+public:
+    /**
+     * @brief Constructs a new ItemNumber object.
+     *
+     * @param key The key of the menu item.
+     * @param start The starting value in fixed point.
+     * @param callback A pointer to the callback function to execute when the
+     * edit ends.
+     */
+    constexpr ItemNumber(MenuText key, T start, fptrInt callback)
+        : ItemNumber(key, start, NULL, callback) {}
+
+    /**
+     * @brief Constructs a new ItemNumber object with a change callback.
+     *
+     * @param changeCallback A pointer to the callback function to execute
+     * when the value changes.
+     */
+    constexpr ItemNumber(MenuText key, T start, fptrInt changeCallback,
+                         fptrInt callback)
+        : ItemValue(key, MENU_ITEM_PROGRESS, changeCallback),
+          callback(callback),
+          value(constrainValue(start)),
+          initialValue(constrainValue(start)) {}
+
+    /**
+     * @brief Returns the value in fixed point.
+     */
+    T getNumber() { return value; }
+
+    /**
+     * @brief Changes the value, it stays between `Min` and `Max`.
+     *
+     * @param number The value in fixed point.
+     */
+    void setNumber(T number)
+    {
+        value = constrainValue(number);
+        markChanged();
+        notifyChange(changeCallback, value);
+    }
+
+    void increment() override { adjust(1); }
+
+    void decrement() override { adjust(-1); }
+
+    /**
+     * @brief Moves the value by several steps at once.
+     *
+     * @param steps The number of steps, negative to decrement.
+     */
+    void adjust(int16_t steps) override
+    {
+        int32_t next = (int32_t)value + (int32_t)steps * Step;
+        next = constrain(next, (int32_t)Min, (int32_t)Max);
+        if (next == value)
+            return;
+        value = next;
+        markChanged();
+        notifyChange(changeCallback, value);
+    }
+
+    /**
+     * Return the stored value for the callbacks
+     */
+    uint16_t getItemIndex() override { return value; }
+
+    void setProgress(uint16_t progress) override { setNumber((T)progress); }
+
+    fptrInt getCallbackInt() override { return callback; }
+
+    /**
+     * @brief Formats the value with its decimals.
+     *
+     * @return The value as text, valid until the next call.
+     */
+    char *getValue() override
+    {
+        static char buffer[8];
+        char *p = buffer + sizeof(buffer) - 1;
+        *p = '\0';
+        bool isNegative = Min < 0 && value < 0;
+        uint16_t n = isNegative ? -(int32_t)value : value;
+        //
+        // write the digits from the right, at least one before the point
+        //
+        uint8_t digits = 0;
+        do
+        {
+            if (Decimals && digits == Decimals)
+                *--p = '.';
+            *--p = '0' + n % 10;
+            n /= 10;
+            digits++;
+        } while (n || digits <= Decimals);
+        if (isNegative)
+            *--p = '-';
+        return p;
+    }
+
+    /**
+     * @brief Draw the value as a bar instead of its digits.
+     *
+     * @param cells The number of characters of the bar, 0 to draw the value.
+     */
+    void setBarCells(uint8_t cells)
+    {
+        barCells = cells;
+        markChanged();
+    }
+
+    uint8_t getBarCells() override { return barCells; }
+
+    uint16_t getBarFill(uint16_t resolution) override
+    {
+        return (uint32_t)((int32_t)value - Min) * resolution /
+               ((int32_t)Max - Min);
+    }
+
+    void saveProgress() override { initialValue = value; }
+
+    void restoreProgress() override
+    {
+        value = initialValue;
+        markChanged();
+    }
+};
+
+#endif // ItemNumber_H
@@ -12,7 +12,7 @@
  * @class ItemProgress
  * @brief ItemProgress indicates that the current item is a list.
  */
-class ItemProgress : public MenuItem
+class ItemProgress final : public ItemValue
 {
 private:
     fptrMapping mapping = NULL;   ///< Pointer to a mapping function
@@ -20,6 +20,7 @@ private:
     uint16_t progress = 0;        ///< The progress
     uint16_t initialProgress = 0; ///< Progress before edit started.
     uint8_t stepLength = 1;
+    uint8_t barCells = 0;          ///< Cells of the bar, 0 to show the value
 
 public:
     /**
@@ -31,43 +32,66 @@ public:
      * @param callback A pointer to the callback function to execute when this
      * menu item is selected.
      */
-    ItemProgress(const char *key, uint16_t start, uint8_t stepLength,
-                 fptrMapping mapping, fptrInt callback)
-        : MenuItem(key, MENU_ITEM_PROGRESS),
+    constexpr ItemProgress(MenuText key, uint16_t start, uint8_t stepLength,
+                           fptrMapping mapping, fptrInt callback)
+        : ItemValue(key, MENU_ITEM_PROGRESS, NULL),
           mapping(mapping),
           callback(callback),
           progress(start),
           initialProgress(start),
           stepLength(stepLength) {}
 
-    ItemProgress(const char *key, uint16_t start, fptrInt callback)
+    /**
+     * @brief Constructs a new ItemProgress object with a change callback.
+     *
+     * @param changeCallback A pointer to the callback function to execute
+     * when the progress changes.
+     */
+    constexpr ItemProgress(MenuText key, uint16_t start, uint8_t stepLength,
+                           fptrMapping mapping, fptrInt changeCallback,
+                           fptrInt callback)
+        : ItemValue(key, MENU_ITEM_PROGRESS, changeCallback),
+          mapping(mapping),
+          callback(callback),
+          progress(start),
+          initialProgress(start),
+          stepLength(stepLength) {}
+
+    constexpr ItemProgress(MenuText key, uint16_t start, fptrInt callback)
         : ItemProgress(key, start, 1, NULL, callback) {}
 
-    ItemProgress(const char *key, fptrInt callback)
+    constexpr ItemProgress(MenuText key, fptrInt callback)
         : ItemProgress(key, 0, 1, NULL, callback) {}
 
-    ItemProgress(const char *key, uint8_t stepLength, fptrMapping mapping,
-                 fptrInt callback)
+    constexpr ItemProgress(MenuText key, uint8_t stepLength,
+                           fptrMapping mapping, fptrInt callback)
         : ItemProgress(key, 0, stepLength, mapping, callback) {}
 
     /**
      * @brief Increments the progress of the list.
      */
-    void increment() override
-    {
-        if (progress >= MAX_PROGRESS)
-            return;
-        progress += stepLength;
-    }
+    void increment() override { adjust(1); }
 
     /**
      * @brief Decrements the progress of the list.
      */
-    void decrement() override
+    void decrement() override { adjust(-1); }
+
+    /**
+     * @brief Moves the progress by several steps at once, the progress stays
+     * between `MIN_PROGRESS` and `MAX_PROGRESS`.
+     *
+     * @param steps The number of steps, negative to decrement.
+     */
+    void adjust(int16_t steps) override
     {
-        if (progress <= MIN_PROGRESS)
+        int32_t value = (int32_t)progress + (int32_t)steps * stepLength;
+        value = constrain(value, MIN_PROGRESS, MAX_PROGRESS);
+        if (value == progress)
             return;
-        progress -= stepLength;
+        progress = value;
+        markChanged();
+        notifyChange(changeCallback, progress);
     }
 
     /**
@@ -104,7 +128,31 @@ public:
         }
     }
 
-    void setProgress(uint16_t p) { progress = p; }
+    /**
+     * @brief Draw the progress as a bar instead of its value.
+     *
+     * @param cells The number of characters of the bar, 0 to draw the value.
+     */
+    void setBarCells(uint8_t cells)
+    {
+        barCells = cells;
+        markChanged();
+    }
+
+    uint8_t getBarCells() override { return barCells; }
+
+    uint16_t getBarFill(uint16_t resolution) override
+    {
+        return (uint32_t)(progress - MIN_PROGRESS) * resolution /
+               (MAX_PROGRESS - MIN_PROGRESS);
+    }
+
+    void setProgress(uint16_t p)
+    {
+        progress = p;
+        markChanged();
+        notifyChange(changeCallback, progress);
+    }
 
     void saveProgress()
     {
@@ -114,6 +162,7 @@ public:
     void restoreProgress()
     {
         progress = initialProgress;
+        markChanged();
     }
 };
 
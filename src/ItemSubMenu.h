@@ -18,7 +18,7 @@ public:
      * @param text text to display for the item
      * @param parent the parent of the sub menu item
      */
-    ItemSubMenu(const char *text, MenuItem **parent)
+    constexpr ItemSubMenu(MenuText text, MenuItem **parent)
         : ItemHeader(text, parent, MENU_ITEM_SUB_MENU) {}
 };
 
@@ -11,9 +11,8 @@
 #define ItemToggle_H
 #include "MenuItem.h"
 
-class ItemToggle : public MenuItem {
+class ItemToggle final : public MenuItem {
    private:
-    bool enabled = false;
     const char* textOn = NULL;
     const char* textOff = NULL;
     fptrInt callback = NULL;
@@ -23,7 +22,7 @@ class ItemToggle : public MenuItem {
      * @param key key of the item
      * @param callback reference to callback function
      */
-    ItemToggle(const char* key, fptrInt callback)
+    constexpr ItemToggle(MenuText key, fptrInt callback)
         : ItemToggle(key, "ON", "OFF", callback) {}
 
     /**
@@ -33,8 +32,8 @@ class ItemToggle : public MenuItem {
      * @param textOff display text when OFF
      * @param callback reference to callback function
      */
-    ItemToggle(const char* key, const char* textOn, const char* textOff,
-               fptrInt callback)
+    constexpr ItemToggle(MenuText key, const char* textOn,
+                         const char* textOff, fptrInt callback)
         : MenuItem(key, MENU_ITEM_TOGGLE),
           textOn(textOn),
           textOff(textOff),
@@ -46,23 +45,21 @@ class ItemToggle : public MenuItem {
      */
     fptrInt getCallbackInt() override { return callback; }
 
-    /**
-     * @brief Get the current state of this toggle item.
-     * @return the current state
-     */
-    boolean isOn() override { return enabled; }
+    const char* getTextOn() { return this->textOn; }
 
-    /**
-     * @brief Set the current state of this toggle item.
-     * @param isOn the new state
-     */
-    void setIsOn(boolean isOn) override { this->enabled = isOn; }
-
-    const char* getTextOn() override { return this->textOn; }
-
-    const char* getTextOff() override { return this->textOff; }
+    const char* getTextOff() { return this->textOff; }
 };
 
+inline const char* MenuItem::getTextOn() {
+    return type == MENU_ITEM_TOGGLE ? static_cast<ItemToggle*>(this)->getTextOn()
+                                    : NULL;
+}
+inline const char* MenuItem::getTextOff() {
+    return type == MENU_ITEM_TOGGLE
+               ? static_cast<ItemToggle*>(this)->getTextOff()
+               : NULL;
+}
+
 #define ITEM_TOGGLE(...) (new ItemToggle(__VA_ARGS__))
 
 #endif
\ No newline at end of file
@@ -29,23 +29,119 @@
 
 #include "Constants.h"
 
+/**
+ * Number of calls to `hide()` and `show()` remembered so the menus update
+ * the visibility of those items only, a menu that missed more of them
+ * checks all its items again. Must be a power of two.
+ */
+#ifndef MENU_VISIBILITY_LOG_SIZE
+#define MENU_VISIBILITY_LOG_SIZE 4
+#endif
+
+/**
+ * Text of a menu item, either in RAM or in flash memory.
+ * A plain string converts to a `MenuText` in RAM, use `FLASH_TEXT()` for a
+ * string declared with `PROGMEM`.
+ */
+struct MenuText
+{
+    const char *text;
+    bool isInFlash;
+
+    constexpr MenuText(const char *text) : text(text), isInFlash(false) {}
+    constexpr MenuText(const char *text, bool isInFlash)
+        : text(text), isInFlash(isInFlash) {}
+};
+
+/**
+ * Use a string stored in flash memory as the text of an item.
+ *
+ * **Example**
+ *
+ * ```cpp
+ * const char startText[] PROGMEM = "Start service";
+ * MenuItem start(FLASH_TEXT(startText));
+ * ```
+ */
+#define FLASH_TEXT(text) MenuText(text, true)
+
+/**
+ * Array of texts, either in RAM or in flash memory.
+ * An array of strings converts to a `MenuTextList` in RAM, use
+ * `FLASH_TEXT_LIST()` for an array declared with `PROGMEM` whose strings are
+ * also declared with `PROGMEM`.
+ */
+struct MenuTextList
+{
+    const char *const *texts;
+    bool isInFlash;
+
+    constexpr MenuTextList(const char *const *texts)
+        : texts(texts), isInFlash(false) {}
+    constexpr MenuTextList(const char *const *texts, bool isInFlash)
+        : texts(texts), isInFlash(isInFlash) {}
+};
+
+/**
+ * Use an array of strings stored in flash memory.
+ *
+ * **Example**
+ *
+ * ```cpp
+ * const char red[] PROGMEM = "Red";
+ * const char green[] PROGMEM = "Green";
+ * const char *const colors[] PROGMEM = {red, green};
+ * ItemList list("Color", FLASH_TEXT_LIST(colors), 2, NULL);
+ * ```
+ */
+#define FLASH_TEXT_LIST(texts) MenuTextList(texts, true)
+
 /**
  * The MenuItem class
+ *
+ * The accessors that belong to a single kind of item, e.g. `getTextOn()` or
+ * `setValue()`, are not virtual, they check the type of the item and forward
+ * to its class, they are defined by the header of that class. The virtual
+ * ones are shared by several kinds of items or overridden by custom items.
  */
 class MenuItem
 {
 protected:
+    //
+    // bits of `flags`
+    //
+    enum : uint8_t
+    {
+        FLAG_HIDDEN = 0x01,
+        FLAG_TEXT_IN_FLASH = 0x02,
+        FLAG_ON = 0x04, ///< state of an `ItemToggle`
+        FLAG_CHANGE_DEFERRED = 0x08,
+    };
+
     const char *text = NULL;
     byte type = MENU_ITEM_NONE;
-    bool hidden = false;
+    /**
+     * State of the item packed in one byte, see `FLAG_*`
+     */
+    uint8_t flags = 0;
+    uint16_t version = 0;
+
+    void logVisibilityChange()
+    {
+        uint16_t revision = ++getVisibilityRevision();
+        getVisibilityLog()[revision % MENU_VISIBILITY_LOG_SIZE] = this;
+    }
 
     /*uint8_t subMenuCursor = 1;
     uint8_t subMenuTop = 0;
     uint8_t subMenuBottom = 0;*/
 
 public:
-    MenuItem(const char *text) : text(text) {}
-    MenuItem(const char *text, byte type) : text(text), type(type) {}
+    constexpr MenuItem(MenuText text)
+        : text(text.text), flags(text.isInFlash ? FLAG_TEXT_IN_FLASH : 0) {}
+    constexpr MenuItem(MenuText text, byte type)
+        : text(text.text), type(type),
+          flags(text.isInFlash ? FLAG_TEXT_IN_FLASH : 0) {}
     /**
      * ## Getters
      */
@@ -53,7 +149,7 @@ public:
     /**
      * `Boolean` state of the item *(either ON or OFF)*
      */
-    virtual boolean isOn() { return false; }
+    boolean isOn() { return flags & FLAG_ON; }
     /**
      * String value of an `ItemInput`
      */
@@ -63,11 +159,29 @@ public:
      * @return `String` - Item's text
      */
     virtual const char *getText() { return text; }
+    /**
+     * Check if the text of the item is stored in flash memory, it must then
+     * be read with `pgm_read_byte()`
+     * @return `bool` - true if the text was given with `FLASH_TEXT()`
+     */
+    bool isTextInFlash() const { return flags & FLAG_TEXT_IN_FLASH; }
+    /**
+     * Get the version of the item, it changes every time the value shown for
+     * the item changes so the menu only formats it again when needed
+     * @return `uint16_t` - version of the item
+     */
+    uint16_t getVersion() const { return version; }
+    /**
+     * Signal that the value shown for the item changed, call it after
+     * modifying the value in place, e.g. the buffer of an `ItemInput` or the
+     * strings of an `ItemList`
+     */
+    void markChanged() { version++; }
     /**
      * Get the callback of the item
      * @return `ftpr` - Item's callback
      */
-    virtual fptr getCallback() { return NULL; }
+    fptr getCallback();
     /**
      * Get the callback of the item
      * @return `fptrInt` - Item's callback
@@ -77,12 +191,12 @@ public:
      * Get the callback of the item
      * @return `fptrStr` - Item's callback
      */
-    virtual fptrStr getCallbackStr() { return NULL; }
+    fptrStr getCallbackStr();
     /**
      * Get the sub menu at item
      * @return `MenuItem*` - Submenu at item
      */
-    virtual MenuItem **getSubMenu() { return NULL; }
+    MenuItem **getSubMenu();
     /**
      * Get the type of the item
      * @return `byte` - type of menu item
@@ -92,12 +206,12 @@ public:
      * Get the text when toggle is ON
      * @return `String` - ON text
      */
-    virtual const char *getTextOn() { return NULL; }
+    const char *getTextOn();
     /**
      * Get the text when toggle is OFF
      * @return `String` - OFF text
      */
-    virtual const char *getTextOff() { return NULL; }
+    const char *getTextOff();
     /**
      * Current index of list for `ItemList`
      */
@@ -110,12 +224,13 @@ public:
     /**
      * Number of items in the list for `ItemList`
      */
-    virtual uint8_t getItemCount() { return 0; };
+    uint8_t getItemCount();
     /**
      * Get the list of items
-     * @return `String*` - List of items
+     * @return `String*` - List of items, `NULL` if the list is not made of
+     * `String`
      */
-    virtual String *getItems() { return NULL; }
+    String *getItems();
     /**
      * @brief Increments the progress of the list.
      */
@@ -129,14 +244,24 @@ public:
      */
 
     /**
-     * `Boolean` state of the item *(either ON or OFF)*
+     * `Boolean` state of the item *(either ON or OFF)*, only changes an
+     * `ItemToggle`
      */
-    virtual void setIsOn(boolean isOn){};
+    void setIsOn(boolean isOn)
+    {
+        if (type != MENU_ITEM_TOGGLE)
+            return;
+        if (isOn)
+            flags |= FLAG_ON;
+        else
+            flags &= ~FLAG_ON;
+        markChanged();
+    }
     /**
      * Set progress in ItemProgress
      * @param progress progress value to set
      */
-    virtual void setProgress(uint16_t progress){};
+    virtual void setProgress(uint16_t /*progress*/){};
     /**
      * Save progress before editing.
     */
@@ -144,21 +269,21 @@ public:
     /**
      * String value of an `ItemInput`
      */
-    virtual void setValue(char *value){};
+    void setValue(char *value);
     /**
      * Set the text of the item
      * @param text text to display for the item
      */
-    void setText(const char *text){};
+    void setText(const char * /*text*/){};
     /**
      * Set the callback on the item
      * @param callback reference to callback function
      */
-    virtual void setCallBack(fptr callback){};
+    void setCallBack(fptr callback);
     /**
      * Current index of list for `ItemList`
      */
-    virtual void setItemIndex(uint16_t itemIndex){};
+    void setItemIndex(uint16_t itemIndex);
 
     /**
      * Operators
@@ -170,17 +295,76 @@ public:
      */
     MenuItem &operator[](const uint8_t index);
 
-    bool isHidden() const { return hidden; }
-    void hide() { hidden = true; }
-    void show() { hidden = false; }
-
-    virtual uint8_t getTop() const { return 0; }
-    virtual uint8_t getBottom() const { return 0; }
-    virtual uint8_t getCursorPosition() const { return 0; }
+    bool isHidden() const { return flags & FLAG_HIDDEN; }
+    void hide()
+    {
+        if (!isHidden())
+        {
+            flags |= FLAG_HIDDEN;
+            logVisibilityChange();
+        }
+    }
+    void show()
+    {
+        if (isHidden())
+        {
+            flags &= ~FLAG_HIDDEN;
+            logVisibilityChange();
+        }
+    }
+    /**
+     * Incremented each time any item is hidden or shown, lets the menu know
+     * when its cached visibility of the items is outdated
+     */
+    static uint16_t &getVisibilityRevision()
+    {
+        static uint16_t revision = 0;
+        return revision;
+    }
+    /**
+     * Items hidden or shown by the last changes, the item of revision `r` is
+     * at `r % MENU_VISIBILITY_LOG_SIZE`
+     */
+    static MenuItem **getVisibilityLog()
+    {
+        static MenuItem *log[MENU_VISIBILITY_LOG_SIZE];
+        return log;
+    }
+    /**
+     * Check if the setters call the change callback of the item
+     * @return `bool` - false while a menu edits the item and calls the
+     * callback later itself
+     */
+    bool isChangeDeferred() const { return flags & FLAG_CHANGE_DEFERRED; }
+    /**
+     * Stop or restart calling the change callback from the setters, the menu
+     * editing the item defers it so that other menus are not affected
+     * @param isDeferred true to not call the change callback
+     */
+    void setChangeDeferred(bool isDeferred)
+    {
+        if (isDeferred)
+            flags |= FLAG_CHANGE_DEFERRED;
+        else
+            flags &= ~FLAG_CHANGE_DEFERRED;
+    }
+    /**
+     * Check if the item is an `ItemHeader`, a header or a sub menu item
+     */
+    bool isHeader() const
+    {
+        return type == MENU_ITEM_MAIN_MENU_HEADER ||
+               type == MENU_ITEM_SUB_MENU_HEADER || type == MENU_ITEM_SUB_MENU ||
+               type == MENU_ITEM_VIRTUAL_MENU;
+    }
 
-    virtual void setTop(uint8_t top) {}
-    virtual void setBottom(uint8_t bottom) {}
-    virtual void setCursorPosition(uint8_t cursorPosition) {}
+    /**
+     * Number of items in the menu starting with this header, header and
+     * footer included
+     * @return `uint8_t` - size of the menu, 0 if unknown
+     */
+    uint8_t getMenuSize() const;
+    void setMenuSize(uint8_t menuSize);
 };
 #define ITEM_BASIC(...) (new MenuItem(__VA_ARGS__))
 
@@ -205,53 +389,57 @@ class ItemHeader : public MenuItem
 {
 protected:
     MenuItem **parent = NULL;
+    uint8_t menuSize = 0;
 
-    uint8_t top;
-    uint8_t bottom;
-    uint8_t cursorPosition;
-
-    ItemHeader(const char *text, MenuItem **parent, byte type)
-        : MenuItem(text, type), parent(parent) {}
+    constexpr ItemHeader(MenuText text, MenuItem **parent, byte type,
+                         uint8_t menuSize = 0)
+        : MenuItem(text, type), parent(parent), menuSize(menuSize) {}
 
 public:
     /**
      */
-    ItemHeader() : ItemHeader("", NULL, MENU_ITEM_MAIN_MENU_HEADER) {}
+    constexpr ItemHeader() : ItemHeader("", NULL, MENU_ITEM_MAIN_MENU_HEADER) {}
     /**
      * @param parent the parent menu item
      */
-    ItemHeader(MenuItem **parent)
+    constexpr ItemHeader(MenuItem **parent)
         : ItemHeader("", parent, MENU_ITEM_SUB_MENU_HEADER) {}
+    /**
+     * @param menuSize number of items in the menu, header and footer included
+     */
+    constexpr ItemHeader(uint8_t menuSize)
+        : ItemHeader("", NULL, MENU_ITEM_MAIN_MENU_HEADER, menuSize) {}
+    /**
+     * @param parent the parent menu item
+     * @param menuSize number of items in the menu, header and footer included
+     */
+    constexpr ItemHeader(MenuItem **parent, uint8_t menuSize)
+        : ItemHeader("", parent, MENU_ITEM_SUB_MENU_HEADER, menuSize) {}
 
-    MenuItem **getSubMenu() override { return this->parent; };
-
-    uint8_t getTop() const override
-    {
-        return top;
-    }
-    uint8_t getBottom() const override
-    {
-        return bottom;
-    }
-    uint8_t getCursorPosition() const override
-    {
-        return cursorPosition;
-    }
+    MenuItem **getSubMenu() { return this->parent; };
 
-    void setTop(uint8_t screenTop) override
-    {
-        top = screenTop;
-    }
-    void setBottom(uint8_t screenBottom) override
-    {
-        bottom = screenBottom;
-    }
-    void setCursorPosition(uint8_t currentCursorPosition) override
-    {
-        cursorPosition = currentCursorPosition;
-    }
+    uint8_t getMenuSize() const { return menuSize; }
+    void setMenuSize(uint8_t size) { menuSize = size; }
 };
 
+//
+// the accessors of `MenuItem` forward to `ItemHeader` based on the type
+//
+inline MenuItem **MenuItem::getSubMenu()
+{
+    return isHeader() ? static_cast<ItemHeader *>(this)->getSubMenu() : NULL;
+}
+inline uint8_t MenuItem::getMenuSize() const
+{
+    return isHeader() ? static_cast<const ItemHeader *>(this)->getMenuSize()
+                      : 0;
+}
+inline void MenuItem::setMenuSize(uint8_t menuSize)
+{
+    if (isHeader())
+        static_cast<ItemHeader *>(this)->setMenuSize(menuSize);
+}
+
 /**
  * ---
  *
@@ -275,15 +463,101 @@ class ItemFooter : public MenuItem
 public:
     /**
      */
-    ItemFooter() : MenuItem(NULL, MENU_ITEM_END_OF_MENU) {}
+    constexpr ItemFooter() : MenuItem(NULL, MENU_ITEM_END_OF_MENU) {}
+};
+
+/**
+ * ---
+ *
+ * # ItemValue
+ *
+ * Base of the items whose value is edited with `left()` and `right()`, the
+ * lists, progress items and numbers. It holds what the menu needs from them
+ * while editing so the other items don't carry it.
+ */
+
+class ItemValue : public MenuItem
+{
+protected:
+    fptrInt changeCallback = NULL; ///< Called when the value changes
+
+    constexpr ItemValue(MenuText key, byte type, fptrInt changeCallback)
+        : MenuItem(key, type), changeCallback(changeCallback) {}
+
+    /**
+     * Call the change callback with the new value of the item, unless it is
+     * deferred
+     * @param changeCallback callback to call, may be `NULL`
+     * @param value new value
+     */
+    void notifyChange(fptrInt changeCallback, uint16_t value)
+    {
+        if (changeCallback != NULL && !isChangeDeferred())
+            changeCallback(value);
+    }
+
+public:
+    /**
+     * Get the callback called when the value of the item changes
+     * @return `fptrInt` - Item's change callback
+     */
+    fptrInt getChangeCallback() const { return changeCallback; }
+    /**
+     * Move the value by several steps at once
+     * @param steps number of steps, negative to decrement
+     */
+    virtual void adjust(int16_t /*steps*/) {}
+    /**
+     * Number of cells of the bar drawn instead of the value of a progress,
+     * 0 to draw the value
+     */
+    virtual uint8_t getBarCells() { return 0; }
+    /**
+     * Filled part of the bar of a progress
+     * @param resolution steps of a full bar
+     * @return `uint16_t` - filled steps, 0 to `resolution`
+     */
+    virtual uint16_t getBarFill(uint16_t /*resolution*/) { return 0; }
 };
 
-#define MAIN_MENU(...)           \
-    extern MenuItem *mainMenu[]; \
-    MenuItem *mainMenu[] = {new ItemHeader(), __VA_ARGS__, new ItemFooter()}
+/**
+ * Only declared, used in `sizeof` to count the items passed to the menu
+ * macros at compile time without evaluating them.
+ */
+template <typename... Items>
+char (&countMenuItems(Items...))[sizeof...(Items)];
 
-#define SUB_MENU(subMenu, parent, ...)                          \
-    MenuItem *subMenu[] = {new ItemHeader(parent), __VA_ARGS__, \
-                           new ItemFooter()}
+/**
+ * Size of a menu made of the given items, header and footer included
+ */
+#define MENU_SIZE(...) (sizeof(countMenuItems(__VA_ARGS__)) + 2)
+
+/**
+ * Declare the main menu. The header and footer are statically allocated,
+ * the items can be created with the `ITEM_*` macros or be the addresses of
+ * statically allocated items to avoid using the heap at all.
+ *
+ * **Example**
+ *
+ * ```cpp
+ * ItemCommand start("Start service", startService);
+ * MAIN_MENU(&start, ITEM_BASIC("Settings"));
+ * ```
+ */
+#define MAIN_MENU(...)                                                  \
+    extern MenuItem *mainMenu[];                                        \
+    static ItemHeader mainMenuHeader(MENU_SIZE(__VA_ARGS__));           \
+    static ItemFooter mainMenuFooter;                                   \
+    MenuItem *mainMenu[] = {&mainMenuHeader, __VA_ARGS__, &mainMenuFooter}
+
+/**
+ * Declare a sub menu, see `MAIN_MENU()`. The parent is only used to go back
+ * from menus entered deeper than `LCD_MENU_MAX_DEPTH`, it can be `NULL` for a
+ * sub menu reached from several menus.
+ */
+#define SUB_MENU(subMenu, parent, ...)                                  \
+    static ItemHeader subMenu##Header(parent, MENU_SIZE(__VA_ARGS__));  \
+    static ItemFooter subMenu##Footer;                                  \
+    MenuItem *subMenu[] = {&subMenu##Header, __VA_ARGS__, &subMenu##Footer}
 
 #endif
\ No newline at end of file
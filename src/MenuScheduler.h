@@ -0,0 +1,136 @@
+/**
+ * ---
+ *
+ * # MenuScheduler
+ *
+ * Drives several menus, e.g. one per display on the same I2C bus, within a
+ * single time budget. Every call to `poll()` polls the menus in turn and
+ * gives each one what is left of the budget, the first menu served changes
+ * from one call to the next so a busy display does not hold back the others.
+ * The menus must render in slices, see `setRenderBudget()`, their own time
+ * budget is replaced by the one of the scheduler, a scheduler without a
+ * budget lets each menu keep its own.
+ *
+ * **Example**
+ *
+ * ```cpp
+ * GenericLcdMenu<LiquidCrystal_I2C> menu(4, 20);
+ * GenericLcdMenu<LiquidCrystal_I2C> status(2, 16);
+ * MenuScheduler scheduler(1000);
+ *
+ * void setup() {
+ *     menu.setRenderBudget(4);
+ *     status.setRenderBudget(4);
+ *     scheduler.add(menu);
+ *     scheduler.add(status);
+ * }
+ *
+ * void loop() { scheduler.poll(); }
+ * ```
+ */
+
+#ifndef MenuScheduler_H
+#define MenuScheduler_H
+#include "GenericLcdMenu.h"
+
+#ifndef MENU_SCHEDULER_MAX_MENUS
+#define MENU_SCHEDULER_MAX_MENUS 4
+#endif
+
+class MenuScheduler
+{
+private:
+    /**
+     * A menu of any display type and the function polling it
+     */
+    struct Entry
+    {
+        void *menu;
+        bool (*poll)(void *menu, uint16_t maxMicros);
+    };
+    Entry entries[MENU_SCHEDULER_MAX_MENUS];
+    uint8_t count = 0;
+    /**
+     * Menu polled first by the next call to `poll()`
+     */
+    uint8_t next = 0;
+    /**
+     * Time budget per call to `poll()` in microseconds, 0 to keep the
+     * budget of each menu
+     */
+    uint16_t maxMicros = 0;
+
+    /**
+     * Poll a menu with what is left of the budget, or with its own budget
+     * when the scheduler has none
+     */
+    template <typename Display>
+    static bool pollMenu(void *menu, uint16_t maxMicros)
+    {
+        GenericLcdMenu<Display> *lcdMenu =
+            static_cast<GenericLcdMenu<Display> *>(menu);
+        return maxMicros ? lcdMenu->poll(maxMicros) : lcdMenu->poll();
+    }
+
+public:
+    /**
+     * @param maxMicros time budget shared by the menus per call to `poll()`
+     * in microseconds, 0 to keep the budget of each menu
+     */
+    MenuScheduler(uint16_t maxMicros = 0) : maxMicros(maxMicros) {}
+    /**
+     * Add a menu to the scheduler
+     * @param menu menu to poll, it must outlive the scheduler
+     * @return `bool` - false if `MENU_SCHEDULER_MAX_MENUS` menus are already
+     * added
+     */
+    template <typename Display>
+    bool add(GenericLcdMenu<Display> &menu)
+    {
+        if (count == MENU_SCHEDULER_MAX_MENUS)
+            return false;
+        entries[count].menu = &menu;
+        entries[count].poll = pollMenu<Display>;
+        count++;
+        return true;
+    }
+    /**
+     * @param maxMicros time budget shared by the menus per call to `poll()`
+     * in microseconds, 0 to keep the budget of each menu
+     */
+    void setTimeBudget(uint16_t maxMicros) { this->maxMicros = maxMicros; }
+    /**
+     * Poll the menus in turn until the time budget is spent, the first menu
+     * always gets the whole budget and the others what is left of it. A menu
+     * that is not reached is polled first by the next call.
+     * @return `bool` - true if changes are still waiting to be sent
+     */
+    bool poll()
+    {
+        unsigned long startMicros = maxMicros ? micros() : 0;
+        bool pending = false;
+        uint8_t index = next;
+        for (uint8_t n = 0; n < count; n++)
+        {
+            uint16_t budget = 0;
+            if (maxMicros)
+            {
+                unsigned long elapsed = micros() - startMicros;
+                if (n && elapsed >= maxMicros)
+                {
+                    next = index;
+                    return true;
+                }
+                budget = n ? maxMicros - elapsed : maxMicros;
+            }
+            pending |= entries[index].poll(entries[index].menu, budget);
+            if (++index == count)
+                index = 0;
+        }
+        if (count && ++next >= count)
+            next = 0;
+        return pending;
+    }
+};
+
+#endif
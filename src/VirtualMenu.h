@@ -0,0 +1,170 @@
+/**
+ * ---
+ *
+ * # VirtualMenu
+ *
+ * A sub menu whose entries are generated on demand, e.g. the files of a
+ * directory on an SD card. Only the entries of a window as high as the
+ * display exist in memory, their text is fetched from a callback by index
+ * when they are drawn and the window moves when the cursor goes past its
+ * first or last entry. The window is sized for the display of the menu it is
+ * shown on when that menu enters it.
+ *
+ * **Example**
+ *
+ * ```cpp
+ * char *fileName(uint16_t index) { ... }
+ * void openFile(uint16_t index) { ... }
+ *
+ * extern MenuItem *mainMenu[];
+ * VirtualMenu files(mainMenu, fileCount, fileName, openFile);
+ *
+ * MAIN_MENU(ITEM_SUBMENU("Files", files.getMenu()));
+ * ```
+ */
+
+#ifndef VirtualMenu_H
+#define VirtualMenu_H
+#include "MenuItem.h"
+
+class VirtualMenu final : public ItemHeader
+{
+private:
+    /**
+     * Entry at a position of the window
+     */
+    class Entry : public MenuItem
+    {
+    public:
+        VirtualMenu *menu = NULL;
+        uint8_t slot = 0;
+
+        constexpr Entry() : MenuItem(NULL, MENU_ITEM_VIRTUAL_ENTRY) {}
+
+        const char *getText() override
+        {
+            const char *text = menu->textCallback(getItemIndex());
+            return text != NULL ? text : "";
+        }
+        uint16_t getItemIndex() override { return menu->offset + slot; }
+        fptrInt getCallbackInt() override { return menu->callback; }
+    };
+
+    uint16_t count;
+    uint16_t offset = 0;
+    fptrMapping textCallback;
+    fptrInt callback;
+    /**
+     * Number of entries in the window, at most `LCD_MAX_ROWS`
+     */
+    uint8_t rows = LCD_MAX_ROWS;
+    Entry entries[LCD_MAX_ROWS];
+    ItemFooter footer;
+    MenuItem *items[LCD_MAX_ROWS + 2];
+
+    /**
+     * Draw all the entries again
+     */
+    void markEntriesChanged()
+    {
+        for (uint8_t i = 0; i < LCD_MAX_ROWS; i++)
+            entries[i].markChanged();
+    }
+
+public:
+    /**
+     * @param parent the parent menu
+     * @param count number of entries
+     * @param textCallback returns the text of the entry at an index, the
+     * text is copied before the callback is called again
+     * @param callback called with the index of the entry when it is entered
+     */
+    VirtualMenu(MenuItem **parent, uint16_t count, fptrMapping textCallback,
+                fptrInt callback)
+        : ItemHeader("", parent, MENU_ITEM_VIRTUAL_MENU),
+          textCallback(textCallback), callback(callback)
+    {
+        items[0] = this;
+        for (uint8_t i = 0; i < LCD_MAX_ROWS; i++)
+        {
+            entries[i].menu = this;
+            entries[i].slot = i;
+        }
+        setCount(count);
+    }
+    /**
+     * Get the items of the window, pass it to `ITEM_SUBMENU()`
+     * @return `MenuItem**` - the items with a header and a footer
+     */
+    MenuItem **getMenu() { return items; }
+    /**
+     * Get the number of entries
+     */
+    uint16_t getCount() { return count; }
+    /**
+     * Change the number of entries, e.g. after reading a directory again.
+     * Call it while the menu isn't displayed.
+     * @param count number of entries
+     */
+    void setCount(uint16_t count)
+    {
+        this->count = count;
+        uint8_t size = min(count, (uint16_t)rows);
+        offset = constrain(offset, 0, count - size);
+        for (uint8_t i = 0; i < size; i++)
+            items[i + 1] = &entries[i];
+        items[size + 1] = &footer;
+        setMenuSize(size + 2);
+        markEntriesChanged();
+    }
+    /**
+     * Get the number of entries in the window
+     */
+    uint8_t getRows() { return rows; }
+    /**
+     * Change the number of entries in the window, the menu sets it to the
+     * rows of its display when it enters this menu
+     * @param rows number of entries, at most `LCD_MAX_ROWS`
+     */
+    void setRows(uint8_t rows)
+    {
+        rows = constrain(rows, 1, LCD_MAX_ROWS);
+        if (rows == this->rows)
+            return;
+        this->rows = rows;
+        setCount(count);
+    }
+    /**
+     * Get the index of the first entry of the window
+     */
+    uint16_t getOffset() { return offset; }
+    /**
+     * Draw the entries again after their text changed
+     */
+    void refresh() { markEntriesChanged(); }
+
+    /**
+     * Check if the window can move
+     * @param isDown true to check the entries after the window
+     * @return `bool` - true if there are entries outside of the window
+     */
+    bool canScroll(bool isDown)
+    {
+        return isDown ? offset + rows < count : offset > 0;
+    }
+    /**
+     * Move the window by one entry
+     * @param isDown true to move to the next entry
+     * @return `bool` - true if the window moved
+     */
+    bool scroll(bool isDown)
+    {
+        if (!canScroll(isDown))
+            return false;
+        offset += isDown ? 1 : -1;
+        markEntriesChanged();
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,107 @@
+#include <ArduinoUnitTests.h>
+#include <ItemList.h>
+#include <ItemProgress.h>
+#include <GenericLcdMenu.h>
+
+#include "MockDisplay.h"
+
+#define LCD_ROWS 2
+#define LCD_COLS 20
+
+uint8_t changes = 0;
+uint16_t lastValue = 0;
+
+void onChange(uint16_t value) {
+    changes++;
+    lastValue = value;
+}
+void onSelect(uint16_t value) {}
+
+const char* colors[] = {"Red", "Green", "Blue", "Black", "White"};
+
+MAIN_MENU(ITEM_STRING_LIST("Color", colors, 5, onChange, onSelect),
+          ITEM_PROGRESS("Volume", 0, 1, NULL, onChange, onSelect));
+
+unittest(change_callback_called_on_each_change_by_default) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    changes = 0;
+    menu.enter();
+    menu.right();
+    menu.right();
+    assertEqual(2, changes);
+    assertEqual(2, lastValue);
+    menu.back();
+}
+
+unittest(deferred_changes_are_called_at_most_once_per_interval) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    menu.setChangeInterval(100);
+    menu.down();
+    menu.enter();
+    changes = 0;
+    for (uint8_t i = 0; i < 30; i++) {
+        delay(10);
+        menu.right();
+        menu.poll();
+    }
+    assertEqual(2, changes);
+    assertEqual(30, mainMenu[2]->getItemIndex());
+    menu.back();
+    assertEqual(3, changes);
+    assertEqual(30, lastValue);
+    menu.setChangeInterval(0);
+}
+
+unittest(deferred_changes_wait_for_the_value_to_settle) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    menu.setChangeInterval(100, true);
+    menu.enter();
+    changes = 0;
+    for (uint8_t i = 0; i < 30; i++) {
+        delay(10);
+        menu.left();
+        menu.poll();
+    }
+    assertEqual(0, changes);
+    delay(100);
+    menu.poll();
+    assertEqual(1, changes);
+    assertEqual(mainMenu[1]->getItemIndex(), lastValue);
+    menu.back();
+    assertEqual(1, changes);
+    menu.setChangeInterval(0);
+}
+
+unittest(deferring_an_item_does_not_silence_the_others) {
+    ItemList color("Color", colors, 5, onChange, onSelect);
+    ItemList shade("Shade", colors, 5, onChange, onSelect);
+    changes = 0;
+    color.setChangeDeferred(true);
+    color.setItemIndex(1);
+    shade.setItemIndex(1);
+    assertEqual(1, changes);
+    color.setChangeDeferred(false);
+    color.setItemIndex(2);
+    assertEqual(2, changes);
+}
+
+unittest(same_index_is_not_a_change) {
+    ItemList color("Color", colors, 5, onChange, onSelect);
+    color.setItemIndex(3);
+    uint16_t version = color.getVersion();
+    changes = 0;
+    color.setItemIndex(3);
+    // clamped to the last item
+    color.setItemIndex(9);
+    color.setItemIndex(9);
+    assertEqual(1, changes);
+    assertEqual(version + 1, color.getVersion());
+}
+
+unittest_main()
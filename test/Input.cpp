@@ -0,0 +1,85 @@
+#include <ArduinoUnitTests.h>
+#include <ItemInput.h>
+#include <GenericLcdMenu.h>
+
+#include "MockDisplay.h"
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+void nameCallback(char* value) {}
+
+char name[6] = "Bob";
+
+MAIN_MENU(ITEM_INPUT("Name", name, sizeof(name), nameCallback),
+          ITEM_INPUT("City", nameCallback));
+
+unittest(input_edits_its_buffer_in_place) {
+    ItemInput input("Name", name, sizeof(name), nameCallback);
+    assertTrue(input.insertChar(0, 'A'));
+    assertTrue(input.replaceChar(1, 'R'));
+    assertTrue(input.removeChar(3));
+    assertEqual("ARo", name);
+    assertEqual(name, input.getValue());
+}
+
+unittest(input_does_not_overflow_its_buffer) {
+    char value[4] = "";
+    ItemInput input("Name", value, sizeof(value), nameCallback);
+    assertTrue(input.replaceChar(0, 'a'));
+    assertTrue(input.insertChar(1, 'b'));
+    assertTrue(input.insertChar(2, 'c'));
+    assertFalse(input.insertChar(3, 'd'));
+    assertFalse(input.insertChar(0, 'd'));
+    assertEqual("abc", value);
+    input.setValue((char*)"long value");
+    assertEqual("lon", value);
+}
+
+unittest(typing_writes_only_the_edited_cell) {
+    strcpy(name, "Bob");
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    menu.enter();
+    menu.left();
+    menu.left();
+    lcd.reset();
+    menu.type('R');
+    assertEqual("Rob", name);
+    assertEqual(1, lcd.writes);
+    menu.insert('o');
+    menu.backspace();
+    assertEqual("Rob", name);
+    assertEqual(name, mainMenu[1]->getValue());
+}
+
+unittest(input_without_buffer_gets_its_own) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    menu.down();
+    menu.enter();
+    menu.type('P');
+    menu.type('a');
+    menu.insert('r');
+    menu.left();
+    menu.backspace();
+    ItemInput* city = static_cast<ItemInput*>(mainMenu[2]);
+    assertEqual("Pr", city->getValue());
+    assertEqual(ITEM_INPUT_CAPACITY, city->getCapacity());
+    city->setBuffer(NULL, 8);
+    assertEqual(ITEM_INPUT_CAPACITY, city->getCapacity());
+    menu.back();
+}
+
+unittest(initial_value_is_copied_to_the_item) {
+    char value[] = "01234567890123456789";
+    ItemInputBuffer<8> input("Name", value, nameCallback);
+    assertEqual("0123456", input.getValue());
+    assertEqual(8, input.getCapacity());
+    assertTrue(input.replaceChar(0, 'A'));
+    assertEqual('0', value[0]);
+}
+
+unittest_main()
@@ -44,6 +44,77 @@ unittest(check_types) {
     assertEqual(MENU_ITEM_TOGGLE, mainMenu[ITEM_TOGGLE_INDEX]->getType());
 }
 
+const char flashText[] PROGMEM = "Flash";
+MenuItem flashItem(FLASH_TEXT(flashText));
+
+unittest(text_in_flash) {
+    assertTrue(flashItem.isTextInFlash());
+    assertFalse(mainMenu[ITEM_INPUT_INDEX]->isTextInFlash());
+}
+
+const char *ramColors[] = {"Red", "Green"};
+const char flashRed[] PROGMEM = "Red";
+const char flashGreen[] PROGMEM = "Green";
+const char *const flashColors[] PROGMEM = {flashRed, flashGreen};
+ItemList ramList("Color", ramColors, 2, toggleCallback);
+ItemList flashList("Color", FLASH_TEXT_LIST(flashColors), 2, toggleCallback);
+
+unittest(list_of_texts) {
+    assertEqual("Green", ramList.getItemText(1).text);
+    assertFalse(ramList.getItemText(1).isInFlash);
+    assertEqual(flashGreen, flashList.getItemText(1).text);
+    assertTrue(flashList.getItemText(1).isInFlash);
+    assertNull(ramList.getItems());
+}
+
+unittest(version_changes_with_the_value) {
+    uint16_t version = mainMenu[ITEM_TOGGLE_INDEX]->getVersion();
+    mainMenu[ITEM_TOGGLE_INDEX]->setIsOn(true);
+    assertNotEqual(version, mainMenu[ITEM_TOGGLE_INDEX]->getVersion());
+    version = ramList.getVersion();
+    ramList.setItemIndex(1);
+    assertNotEqual(version, ramList.getVersion());
+}
+
+unittest(menu_size_counted_by_macro) {
+    assertEqual(8, mainMenu[ITEM_MAIN_HEADER_INDEX]->getMenuSize());
+}
+
+unittest(sub_menu_only_on_headers) {
+    assertNull(mainMenu[ITEM_MAIN_HEADER_INDEX]->getSubMenu());
+    assertNull(mainMenu[ITEM_COMMAND_INDEX]->getSubMenu());
+    assertEqual(0, mainMenu[ITEM_COMMAND_INDEX]->getMenuSize());
+}
+
+unittest(packed_state_bits_are_independent) {
+    MenuItem* toggle = mainMenu[ITEM_TOGGLE_INDEX];
+    toggle->hide();
+    toggle->setIsOn(true);
+    assertTrue(toggle->isHidden());
+    assertTrue(toggle->isOn());
+    assertFalse(toggle->isTextInFlash());
+    toggle->show();
+    assertTrue(toggle->isOn());
+    toggle->setIsOn(false);
+    assertFalse(toggle->isHidden());
+    assertFalse(toggle->isOn());
+}
+
+unittest(accessors_only_affect_their_kind_of_item) {
+    MenuItem* command = mainMenu[ITEM_COMMAND_INDEX];
+    uint16_t version = command->getVersion();
+    command->setIsOn(true);
+    command->setValue((char*)"TEST");
+    command->setItemIndex(1);
+    assertFalse(command->isOn());
+    assertNull(command->getValue());
+    assertEqual(0, command->getItemCount());
+    assertEqual(version, command->getVersion());
+    assertEqual(commandCallback, command->getCallback());
+    assertNull(mainMenu[ITEM_TOGGLE_INDEX]->getCallback());
+    assertNull(command->getCallbackStr());
+}
+
 unittest(can_set_input_value) {
     char* expected = "TEST";
     assertEqual("", mainMenu[ITEM_INPUT_INDEX]->getValue());
@@ -0,0 +1,85 @@
+#define ENABLE_MENU_STATS
+#include <ArduinoUnitTests.h>
+#include <ItemLive.h>
+#include <GenericLcdMenu.h>
+
+#include "MockDisplay.h"
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+uint16_t temperature = 20;
+uint16_t reads = 0;
+
+char* readTemperature() {
+    static char text[8];
+    reads++;
+    snprintf(text, sizeof text, "%u", temperature);
+    return text;
+}
+
+MAIN_MENU(ITEM_BASIC("Start"), ITEM_LIVE("Temp", readTemperature, 500),
+          ITEM_BASIC("Settings"), ITEM_BASIC("About"));
+
+unittest(only_the_changed_value_is_sent) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    assertEqual(" Temp:20       v    ", lcd.line(1));
+    delay(500);
+    temperature = 21;
+    lcd.reset();
+    menu.resetStats();
+    menu.poll();
+    assertEqual(" Temp:21       v    ", lcd.line(1));
+    assertEqual(0, menu.getStats().updates);
+    assertEqual(1, lcd.writes);
+    // same value, nothing is sent
+    delay(500);
+    lcd.reset();
+    menu.poll();
+    assertEqual(0, lcd.bytes());
+}
+
+unittest(reads_are_rate_limited) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    delay(500);
+    menu.poll();
+    reads = 0;
+    for (uint8_t i = 0; i < 10; i++) {
+        delay(100);
+        menu.poll();
+    }
+    assertEqual(2, reads);
+}
+
+unittest(not_read_out_of_view) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    menu.down();
+    menu.down();
+    menu.down();
+    reads = 0;
+    delay(1000);
+    menu.poll();
+    assertEqual(0, reads);
+}
+
+unittest(every_changed_character_is_seen) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    // the same buffer is read each time, only its text changes
+    for (temperature = 100; temperature < 400; temperature++) {
+        delay(500);
+        menu.poll();
+        char expected[sizeof " Temp:65535      v    "];
+        snprintf(expected, sizeof expected, " Temp:%u      v    ", temperature);
+        assertEqual(expected, lcd.line(1));
+    }
+}
+
+unittest_main()
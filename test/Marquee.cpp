@@ -0,0 +1,66 @@
+#include <ArduinoUnitTests.h>
+#include <GenericLcdMenu.h>
+
+#include "MockDisplay.h"
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+MAIN_MENU(ITEM_BASIC("Connect to the WiFi network"), ITEM_BASIC("Settings"),
+          ITEM_BASIC("About"));
+
+/**
+ * Let the marquee take a step
+ */
+void step(GenericLcdMenu<MockDisplay>& menu) {
+    delay(300);
+    menu.poll();
+}
+
+unittest(long_label_scrolls_on_its_line_only) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    menu.setMarquee(300);
+    menu.poll();
+    step(menu);
+    assertEqual(">Connect to the     ", lcd.line(0));
+    lcd.reset();
+    step(menu);
+    assertEqual(">onnect to the W    ", lcd.line(0));
+    assertEqual(1, lcd.countRowsWritten());
+    for (uint8_t i = 0; i < 11; i++) step(menu);
+    assertEqual(">he WiFi network    ", lcd.line(0));
+    // starts over after the last character
+    step(menu);
+    assertEqual(">Connect to the     ", lcd.line(0));
+}
+
+unittest(stops_on_navigation) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    menu.setMarquee(300);
+    menu.poll();
+    step(menu);
+    step(menu);
+    step(menu);
+    assertEqual(">nnect to the Wi    ", lcd.line(0));
+    menu.down();
+    assertEqual(" Connect to the     ", lcd.line(0));
+    // short labels stay still
+    step(menu);
+    step(menu);
+    step(menu);
+    assertEqual(">Settings      v    ", lcd.line(1));
+}
+
+unittest(disabled_by_default) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    for (uint8_t i = 0; i < 5; i++) step(menu);
+    assertEqual(">Connect to the     ", lcd.line(0));
+}
+
+unittest_main()
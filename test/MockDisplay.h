@@ -0,0 +1,119 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+ * Display that records what is drawn on it and counts the calls made by the
+ * menu, used to check how much is sent to the display.
+ */
+class MockDisplay {
+   public:
+    //
+    // a HD44780 behind a PCF8574 receives each byte as two nibbles, each
+    // nibble takes three transmissions of the address and one byte
+    //
+    static const uint8_t I2C_BYTES_PER_COMMAND = 12;
+
+    uint16_t clears = 0;
+    uint16_t cursors = 0;
+    uint16_t writes = 0;
+    uint16_t commands = 0;
+    uint8_t rowsWritten = 0;
+    char screen[4][21];
+    uint8_t col = 0;
+    uint8_t row = 0;
+    bool isBlinking = false;
+    bool isOn = true;
+    uint8_t backlight = HIGH;
+    // time taken by each character, e.g. to share a bus with another display
+    unsigned int writeMicros = 0;
+
+    MockDisplay() { wipe(); }
+
+    void wipe() {
+        for (uint8_t r = 0; r < 4; r++) {
+            memset(screen[r], ' ', 20);
+            screen[r][20] = '\0';
+        }
+    }
+    /**
+     * Forget the calls made so far
+     */
+    void reset() {
+        clears = cursors = writes = commands = 0;
+        rowsWritten = 0;
+    }
+    /**
+     * @return `uint16_t` - bytes sent to the display
+     */
+    uint16_t bytes() { return clears + cursors + writes + commands; }
+    /**
+     * @return `uint16_t` - bytes sent on the bus by `LiquidCrystal_I2C`
+     */
+    uint16_t i2cBytes() { return bytes() * I2C_BYTES_PER_COMMAND; }
+    /**
+     * Get a row of the display, the cursors and the arrows of the menu are
+     * replaced by `>`, `<`, `^` and `v`
+     * @param r row
+     * @return `const char*` - text of the row
+     */
+    const char* line(uint8_t r) {
+        static char text[21];
+        for (uint8_t c = 0; c <= 20; c++) {
+            uint8_t ch = screen[r][c];
+            text[c] = ch == 0x7E ? '>' : ch == 0x7F ? '<' : ch == 0 && c < 20 ? '^' : ch == 1 ? 'v' : ch;
+        }
+        return text;
+    }
+    /**
+     * @return `uint8_t` - number of rows characters were written on
+     */
+    uint8_t countRowsWritten() {
+        uint8_t n = 0;
+        for (uint8_t r = 0; r < 4; r++) n += (rowsWritten >> r) & 1;
+        return n;
+    }
+
+    void clear() {
+        clears++;
+        wipe();
+        col = row = 0;
+    }
+    void setCursor(uint8_t c, uint8_t r) {
+        cursors++;
+        col = c;
+        row = r;
+    }
+    size_t write(uint8_t c) {
+        writes++;
+        if (writeMicros) delayMicroseconds(writeMicros);
+        if (row < 4 && col < 20) {
+            screen[row][col] = c;
+            rowsWritten |= 1 << row;
+        }
+        col++;
+        return 1;
+    }
+    void createChar(uint8_t, uint8_t[]) { commands += 9; }
+    void blink() {
+        commands++;
+        isBlinking = true;
+    }
+    void noBlink() {
+        commands++;
+        isBlinking = false;
+    }
+    void display() {
+        commands++;
+        isOn = true;
+    }
+    void noDisplay() {
+        commands++;
+        isOn = false;
+    }
+    void setBacklight(uint8_t state) {
+        commands++;
+        backlight = state;
+    }
+    void noBacklight() { setBacklight(LOW); }
+    void flush() {}
+};
@@ -0,0 +1,200 @@
+#define ENABLE_MENU_STATS
+#include <ArduinoUnitTests.h>
+#include <ItemInput.h>
+#include <ItemSubMenu.h>
+#include <GenericLcdMenu.h>
+
+#include "MockDisplay.h"
+
+#define LCD_ROWS 2
+#define LCD_COLS 20
+
+extern MenuItem* mainMenu[];
+extern MenuItem* settingsMenu[];
+extern MenuItem* networkMenu[];
+
+// reached from the main menu and from the settings, without a parent
+SUB_MENU(networkMenu, NULL, ITEM_BASIC("WiFi"), ITEM_BASIC("Ethernet"));
+
+SUB_MENU(settingsMenu, mainMenu, ITEM_BASIC("Contrast"),
+         ITEM_BASIC("Brightness"), ITEM_SUBMENU("Network", networkMenu));
+
+MAIN_MENU(ITEM_BASIC("Start"), ITEM_SUBMENU("Settings", settingsMenu),
+          ITEM_BASIC("About"), ITEM_SUBMENU("Network", networkMenu));
+
+uint8_t submits = 0;
+void submitCallback(char*) { submits++; }
+
+extern MenuItem* longMenu[];
+SUB_MENU(longMenu, NULL, ITEM_INPUT("A1", submitCallback), ITEM_BASIC("B2"),
+         ITEM_BASIC("C3"), ITEM_BASIC("D4"), ITEM_BASIC("E5"),
+         ITEM_BASIC("F6"), ITEM_BASIC("G7"), ITEM_BASIC("H8"));
+
+unittest(back_returns_to_the_menu_it_came_from) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    // main menu -> network
+    for (uint8_t i = 0; i < 3; i++) menu.down();
+    menu.enter();
+    assertEqual(">WiFi               ", lcd.line(0));
+    menu.back();
+    assertEqual(4, menu.getCursorPosition());
+    assertEqual(">Network            ", lcd.line(1));
+    // main menu -> settings -> network
+    menu.up();
+    menu.up();
+    menu.enter();
+    menu.down();
+    menu.down();
+    menu.enter();
+    assertEqual(">WiFi               ", lcd.line(0));
+    menu.back();
+    assertEqual(3, menu.getCursorPosition());
+    assertEqual(">Network            ", lcd.line(1));
+    menu.back();
+    assertEqual(2, menu.getCursorPosition());
+    // already in the main menu
+    menu.back();
+    assertEqual(2, menu.getCursorPosition());
+}
+
+unittest(home_leaves_all_sub_menus) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    menu.down();
+    menu.enter();
+    menu.down();
+    menu.down();
+    menu.enter();
+    menu.down();
+    menu.home();
+    assertFalse(menu.isSubMenu());
+    assertEqual(2, menu.getCursorPosition());
+    assertEqual(">Settings          v", lcd.line(1));
+    menu.home();
+    assertEqual(2, menu.getCursorPosition());
+}
+
+unittest(navigate_by_path_draws_once) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    menu.resetStats();
+    const uint8_t ethernet[] = {2, 3, 2};
+    assertTrue(menu.navigateTo(ethernet, 3));
+    assertEqual(1, menu.getStats().updates);
+    assertEqual(" WiFi               ", lcd.line(0));
+    assertEqual(">Ethernet           ", lcd.line(1));
+    menu.back();
+    assertEqual(3, menu.getCursorPosition());
+    assertEqual(">Network            ", lcd.line(1));
+    menu.back();
+    assertEqual(2, menu.getCursorPosition());
+    assertFalse(menu.isSubMenu());
+}
+
+unittest(invalid_path_is_ignored) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    const uint8_t notASubMenu[] = {1, 1};
+    const uint8_t pastTheEnd[] = {2, 4};
+    assertFalse(menu.navigateTo(notASubMenu, 2));
+    assertFalse(menu.navigateTo(pastTheEnd, 2));
+    assertFalse(menu.isSubMenu());
+    assertEqual(1, menu.getCursorPosition());
+}
+
+unittest(navigate_to_menu_finds_its_path) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    assertTrue(menu.navigateTo(settingsMenu, 3));
+    assertEqual(" Brightness        ^", lcd.line(0));
+    assertEqual(">Network            ", lcd.line(1));
+    menu.back();
+    assertEqual(2, menu.getCursorPosition());
+    assertTrue(menu.navigateTo(mainMenu, 4));
+    assertEqual(">Network            ", lcd.line(1));
+}
+
+unittest(jump_to_letter) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    assertTrue(menu.jumpTo('s'));
+    assertEqual(2, menu.getCursorPosition());
+    // wraps around to the first match
+    assertTrue(menu.jumpTo('S'));
+    assertEqual(1, menu.getCursorPosition());
+    assertTrue(menu.jumpTo('n'));
+    assertEqual(4, menu.getCursorPosition());
+    assertEqual(" About             ^", lcd.line(0));
+    assertEqual(">Network            ", lcd.line(1));
+    assertFalse(menu.jumpTo('x'));
+    assertEqual(4, menu.getCursorPosition());
+    // hidden items are skipped
+    mainMenu[3]->hide();
+    assertFalse(menu.jumpTo('a'));
+    mainMenu[3]->show();
+    assertTrue(menu.jumpTo('a'));
+    assertEqual(3, menu.getCursorPosition());
+}
+
+unittest(navigate_past_a_hidden_item) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(4, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, longMenu);
+    longMenu[3]->hide();
+    const uint8_t f6[] = {6};
+    assertTrue(menu.navigateTo(f6, 1));
+    assertEqual(6, menu.getCursorPosition());
+    assertEqual(' ', lcd.line(0)[0]);
+    assertEqual(">F6                 ", lcd.line(1));
+    assertEqual(" G7                 ", lcd.line(2));
+    longMenu[3]->show();
+}
+
+unittest(navigate_cancels_the_edit_without_callback) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(4, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, longMenu);
+    menu.enter();
+    assertTrue(menu.isInEditMode());
+    submits = 0;
+    menu.resetStats();
+    const uint8_t b2[] = {2};
+    assertTrue(menu.navigateTo(b2, 1));
+    assertFalse(menu.isInEditMode());
+    assertEqual(0, submits);
+    assertEqual(1, menu.getStats().updates);
+    assertEqual(1, menu.getStats().menuDraws);
+    assertEqual(">B2                ^", lcd.line(0));
+    // home() in the main menu only draws the end of the edit
+    menu.up();
+    menu.enter();
+    menu.resetStats();
+    menu.home();
+    assertFalse(menu.isInEditMode());
+    assertEqual(0, submits);
+    assertEqual(1, menu.getStats().menuDraws);
+}
+
+unittest(jump_past_a_hidden_item) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(4, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, longMenu);
+    longMenu[3]->hide();
+    assertTrue(menu.jumpTo('f'));
+    assertEqual(6, menu.getCursorPosition());
+    assertEqual(">F6                 ", lcd.line(1));
+    // on the window but below the hidden item
+    assertTrue(menu.jumpTo('d'));
+    assertEqual(4, menu.getCursorPosition());
+    assertEqual(">D4                ^", lcd.line(0));
+    longMenu[3]->show();
+}
+
+unittest_main()
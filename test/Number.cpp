@@ -0,0 +1,60 @@
+#include <ArduinoUnitTests.h>
+#include <ItemNumber.h>
+#include <GenericLcdMenu.h>
+
+#include "MockDisplay.h"
+
+#define LCD_ROWS 2
+#define LCD_COLS 20
+
+uint16_t numberValue = 0;
+
+void numberCallback(uint16_t value) { numberValue = value; }
+
+ItemNumber<int16_t, -100, 100, 5, 2> current("Curr", 0, numberCallback);
+ItemNumber<uint8_t, 0, 200> distance("Dist", 150, numberCallback);
+
+MAIN_MENU(&current, &distance);
+
+unittest(number_is_formatted_with_its_decimals) {
+    ItemNumber<int16_t, -1000, 1000, 1, 2> number("N", 5, NULL);
+    assertEqual("0.05", number.getValue());
+    number.setNumber(-125);
+    assertEqual("-1.25", number.getValue());
+    number.setNumber(1000);
+    assertEqual("10.00", number.getValue());
+    ItemNumber<uint16_t, 0, 60000> big("N", 60000, NULL);
+    assertEqual("60000", big.getValue());
+}
+
+unittest(number_stays_in_its_range) {
+    ItemNumber<int16_t, -100, 100, 5, 2> number("N", 90, NULL);
+    number.increment();
+    number.increment();
+    number.increment();
+    assertEqual(100, number.getNumber());
+    number.adjust(-100);
+    assertEqual(-100, number.getNumber());
+    ItemNumber<uint8_t, 10, 20> small("N", 0, NULL);
+    assertEqual(10, small.getNumber());
+}
+
+unittest(number_is_edited_by_the_menu) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    assertEqual(">Curr:0.00          ", lcd.line(0));
+    assertEqual(" Dist:150           ", lcd.line(1));
+    menu.enter();
+    menu.left();
+    menu.left();
+    assertEqual("<Curr:-0.10         ", lcd.line(0));
+    menu.back();
+    assertEqual(-10, (int16_t)numberValue);
+    menu.enter();
+    menu.right();
+    menu.back(true);
+    assertEqual(-10, current.getNumber());
+}
+
+unittest_main()
@@ -0,0 +1,101 @@
+#define ENABLE_MENU_STATS
+#include <ArduinoUnitTests.h>
+#include <GenericLcdMenu.h>
+
+#include "MockDisplay.h"
+
+#define LCD_ROWS 4
+#define LCD_COLS 20
+
+MAIN_MENU(ITEM_BASIC("Item 1"), ITEM_BASIC("Item 2"), ITEM_BASIC("Item 3"),
+          ITEM_BASIC("Item 4"), ITEM_BASIC("Item 5"), ITEM_BASIC("Item 6"),
+          ITEM_BASIC("Item 7"), ITEM_BASIC("Item 8"), ITEM_BASIC("Item 9"),
+          ITEM_BASIC("Item 10"));
+
+unittest(page_down_and_up) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    menu.resetStats();
+    assertTrue(menu.pageDown());
+    assertEqual(5, menu.getCursorPosition());
+    assertEqual(1, menu.getStats().menuDraws);
+    assertEqual(">Item 5            ^", lcd.line(0));
+    assertEqual(" Item 8            v", lcd.line(3));
+    // the last page stays full
+    assertTrue(menu.pageDown());
+    assertEqual(9, menu.getCursorPosition());
+    assertEqual(" Item 7            ^", lcd.line(0));
+    assertEqual(">Item 9             ", lcd.line(2));
+    assertEqual(" Item 10            ", lcd.line(3));
+    assertTrue(menu.pageDown());
+    assertEqual(10, menu.getCursorPosition());
+    assertFalse(menu.pageDown());
+    assertTrue(menu.pageUp());
+    assertEqual(6, menu.getCursorPosition());
+    assertEqual(">Item 6            ^", lcd.line(0));
+    assertTrue(menu.pageUp());
+    assertTrue(menu.pageUp());
+    assertEqual(1, menu.getCursorPosition());
+    assertFalse(menu.pageUp());
+}
+
+unittest(pages_skip_hidden_items) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    mainMenu[3]->hide();
+    mainMenu[4]->hide();
+    menu.pageDown();
+    assertEqual(7, menu.getCursorPosition());
+    assertEqual(">Item 7            ^", lcd.line(0));
+    menu.pageUp();
+    assertEqual(1, menu.getCursorPosition());
+    assertEqual(">Item 1             ", lcd.line(0));
+    assertEqual(" Item 2             ", lcd.line(1));
+    assertEqual(" Item 5             ", lcd.line(2));
+    mainMenu[3]->show();
+    mainMenu[4]->show();
+}
+
+unittest(scrolled_lines_are_copied) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    for (uint8_t i = 0; i < 3; i++) menu.down();
+    menu.resetStats();
+    // item 4 moves to the first line
+    menu.down();
+    assertEqual(3, menu.getStats().itemDraws);
+    assertEqual(1, menu.getStats().rowsReused);
+    menu.up();
+    menu.resetStats();
+    // one line scrolled in, three copied
+    menu.up();
+    assertEqual(1, menu.getStats().itemDraws);
+    assertEqual(3, menu.getStats().rowsReused);
+    assertEqual(">Item 3            ^", lcd.line(0));
+    assertEqual(" Item 4             ", lcd.line(1));
+    assertEqual(" Item 6            v", lcd.line(3));
+}
+
+unittest(wrap_around) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    assertFalse(menu.up());
+    menu.setWrapAround(true);
+    assertTrue(menu.up());
+    assertEqual(10, menu.getCursorPosition());
+    assertEqual(" Item 7            ^", lcd.line(0));
+    assertEqual(">Item 10            ", lcd.line(3));
+    assertTrue(menu.down());
+    assertEqual(1, menu.getCursorPosition());
+    assertEqual(">Item 1             ", lcd.line(0));
+    assertTrue(menu.pageUp());
+    assertEqual(10, menu.getCursorPosition());
+    assertTrue(menu.pageDown());
+    assertEqual(1, menu.getCursorPosition());
+}
+
+unittest_main()
@@ -0,0 +1,155 @@
+#include <ArduinoUnitTests.h>
+#include <ItemProgress.h>
+#include <GenericLcdMenu.h>
+
+#include "MockDisplay.h"
+
+#define LCD_ROWS 2
+#define LCD_COLS 20
+
+void volumeCallback(uint16_t value) {}
+
+MAIN_MENU(ITEM_PROGRESS("Volume", 10, NULL, volumeCallback),
+          ITEM_BASIC("About"));
+
+unittest(adjust_applies_many_steps_at_once) {
+    ItemProgress volume("Volume", 10, NULL, volumeCallback);
+    uint16_t version = volume.getVersion();
+    volume.adjust(25);
+    assertEqual(250, volume.getItemIndex());
+    assertEqual(version + 1, volume.getVersion());
+    volume.adjust(200);
+    assertEqual(MAX_PROGRESS, volume.getItemIndex());
+    volume.adjust(-200);
+    assertEqual(MIN_PROGRESS, volume.getItemIndex());
+}
+
+unittest(held_button_speeds_up) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    menu.setAcceleration(100);
+    mainMenu[1]->setProgress(0);
+    menu.enter();
+    for (uint8_t i = 0; i < 16; i++) {
+        delay(50);
+        menu.right();
+    }
+    // 4 steps of each speed: 4 * (1 + 2 + 4 + 8) steps of 10
+    assertEqual(600, mainMenu[1]->getItemIndex());
+    delay(200);
+    menu.right();
+    assertEqual(610, mainMenu[1]->getItemIndex());
+    menu.back();
+}
+
+unittest(accelerated_steps_do_not_overflow) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    menu.setAcceleration(100);
+    mainMenu[1]->setProgress(0);
+    menu.enter();
+    for (uint8_t i = 0; i < 8; i++) {
+        delay(10);
+        menu.adjust(20000);
+    }
+    assertEqual(MAX_PROGRESS, mainMenu[1]->getItemIndex());
+    for (uint8_t i = 0; i < 8; i++) {
+        delay(10);
+        menu.adjust(-20000);
+    }
+    assertEqual(MIN_PROGRESS, mainMenu[1]->getItemIndex());
+    delay(200);
+    menu.back();
+}
+
+unittest(redraws_are_limited_while_editing) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    menu.setProgressRefreshInterval(100);
+    mainMenu[1]->setProgress(0);
+    menu.enter();
+    delay(200);
+    menu.adjust(5);
+    assertEqual("<Volume:50          ", lcd.line(0));
+    for (uint8_t i = 0; i < 5; i++) {
+        delay(10);
+        menu.right();
+    }
+    assertEqual("<Volume:50          ", lcd.line(0));
+    delay(100);
+    menu.poll();
+    assertEqual("<Volume:100         ", lcd.line(0));
+    menu.back();
+}
+
+ItemProgress level("Level", 500, 50, NULL, volumeCallback);
+SUB_MENU(barMenu, NULL, &level, ITEM_BASIC("About"));
+
+unittest(bar_drawn_with_custom_characters) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    level.setBarCells(4);
+    menu.setupLcdWithMenu(lcd, barMenu);
+    assertEqual(0, strncmp(">Level:", lcd.line(0), 7));
+    assertEqual(0xFF, (uint8_t)lcd.screen[0][7]);
+    assertEqual(0xFF, (uint8_t)lcd.screen[0][8]);
+    assertEqual(' ', lcd.screen[0][9]);
+    assertEqual(' ', lcd.screen[0][10]);
+    // one more column only changes one character
+    menu.enter();
+    lcd.reset();
+    menu.right();
+    assertEqual(2, (uint8_t)lcd.screen[0][9]);
+    assertEqual(1, lcd.writes);
+    menu.left();
+    menu.back();
+    level.setBarCells(0);
+}
+
+unittest(glyphs_reserved_after_the_bar) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    level.setBarCells(4);
+    menu.setupLcdWithMenu(lcd, barMenu);
+    assertEqual(6, menu.reserveGlyphs(2));
+    assertEqual(-1, menu.reserveGlyphs(1));
+    level.setBarCells(0);
+}
+
+unittest(glyphs_sent_with_the_frame) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, barMenu);
+    menu.setRenderBudget(4);
+    lcd.reset();
+    level.setBarCells(4);
+    menu.update();
+    assertEqual(0, lcd.bytes());
+    menu.poll();
+    assertTrue(lcd.commands >= 4 * 9);
+    while (menu.poll()) {
+    }
+    assertEqual(0xFF, (uint8_t)lcd.screen[0][7]);
+    level.setBarCells(0);
+}
+
+unittest(glyphs_not_sent_while_asleep) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, barMenu, 1000);
+    delay(1000);
+    menu.updateTimer();
+    lcd.reset();
+    level.setBarCells(4);
+    menu.update();
+    menu.poll();
+    assertEqual(0, lcd.bytes());
+    menu.wake();
+    assertEqual(0xFF, (uint8_t)lcd.screen[0][7]);
+    level.setBarCells(0);
+}
+
+unittest_main()
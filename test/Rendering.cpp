@@ -0,0 +1,162 @@
+#include <ArduinoUnitTests.h>
+#include <ItemCommand.h>
+#include <ItemToggle.h>
+#include <GenericLcdMenu.h>
+
+#include "MockDisplay.h"
+
+#define LCD_ROWS 4
+#define LCD_COLS 20
+
+void renderingCallback() {}
+// item hidden while the toggle is on, none by default
+MenuItem* hiddenByToggle = NULL;
+void renderingToggleCallback(uint16_t isOn) {
+    if (hiddenByToggle == NULL) return;
+    if (isOn)
+        hiddenByToggle->hide();
+    else
+        hiddenByToggle->show();
+}
+
+MAIN_MENU(ITEM_BASIC("Start service"), ITEM_BASIC("Connect to WiFi"),
+          ITEM_TOGGLE("Backlight", renderingToggleCallback),
+          ITEM_COMMAND("Blink SOS", renderingCallback),
+          ITEM_BASIC("Blink random"), ITEM_BASIC("Settings"),
+          ITEM_BASIC("About"));
+
+unittest(setup_draws_each_character_once) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    assertEqual(1, lcd.clears);
+    assertMoreOrEqual(LCD_ROWS * LCD_COLS, lcd.writes);
+    assertEqual(">Start service      ", lcd.line(0));
+    assertEqual(" Blink SOS         v", lcd.line(3));
+}
+
+unittest(update_without_changes_writes_nothing) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    lcd.reset();
+    menu.update();
+    assertEqual(0, lcd.writes);
+    assertEqual(0, lcd.cursors);
+}
+
+unittest(down_in_view_only_moves_the_cursor) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    lcd.reset();
+    menu.down();
+    assertEqual(2, lcd.writes);
+    assertMoreOrEqual(2, lcd.cursors);
+    assertMoreOrEqual(8, lcd.bytes());
+    assertMoreOrEqual(8 * MockDisplay::I2C_BYTES_PER_COMMAND, lcd.i2cBytes());
+    assertEqual(" Start service      ", lcd.line(0));
+    assertEqual(">Connect to WiFi    ", lcd.line(1));
+}
+
+unittest(scrolling_rewrites_at_most_the_screen) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    for (uint8_t i = 0; i < 3; i++) menu.down();
+    lcd.reset();
+    menu.down();
+    assertEqual(5, menu.getCursorPosition());
+    assertMoreOrEqual(LCD_ROWS * LCD_COLS, lcd.writes);
+    assertMoreOrEqual(LCD_ROWS * 3, lcd.cursors);
+    assertEqual(">Blink random       ", lcd.line(1));
+}
+
+unittest(toggle_redraws_only_its_row) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    menu.down();
+    menu.down();
+    lcd.reset();
+    menu.enter();
+    assertEqual(1, lcd.countRowsWritten());
+    assertMoreOrEqual(3, lcd.writes);
+    assertEqual(">Backlight:ON       ", lcd.line(2));
+    menu.enter();
+}
+
+unittest(change_after_many_versions_is_drawn) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    assertEqual(" Backlight:OFF      ", lcd.line(2));
+    // 256 changes between two draws
+    mainMenu[3]->setIsOn(true);
+    for (uint16_t i = 0; i < 255; i++) {
+        mainMenu[3]->markChanged();
+    }
+    menu.update();
+    assertEqual(" Backlight:ON       ", lcd.line(2));
+    mainMenu[3]->setIsOn(false);
+}
+
+unittest(item_hidden_by_a_callback_is_erased) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    hiddenByToggle = mainMenu[4];
+    menu.down();
+    menu.down();
+    menu.enter();
+    assertEqual(">Backlight:ON       ", lcd.line(2));
+    assertEqual(" Blink random      v", lcd.line(3));
+    menu.down();
+    assertEqual(5, menu.getCursorPosition());
+    assertEqual(">Blink random      v", lcd.line(3));
+    menu.up();
+    menu.enter();
+    assertEqual(">Backlight:OFF      ", lcd.line(2));
+    assertEqual(" Blink SOS         v", lcd.line(3));
+    hiddenByToggle = NULL;
+}
+
+unittest(queued_events_draw_once) {
+    MockDisplay direct;
+    GenericLcdMenu<MockDisplay> directMenu(LCD_ROWS, LCD_COLS);
+    directMenu.setupLcdWithMenu(direct, mainMenu);
+    MockDisplay queued;
+    GenericLcdMenu<MockDisplay> queuedMenu(LCD_ROWS, LCD_COLS);
+    queuedMenu.setupLcdWithMenu(queued, mainMenu);
+    direct.reset();
+    queued.reset();
+    for (uint8_t i = 0; i < 5; i++) {
+        directMenu.down();
+        queuedMenu.pushEvent(MENU_EVENT_DOWN);
+    }
+    queuedMenu.poll();
+    assertEqual(directMenu.getCursorPosition(),
+                queuedMenu.getCursorPosition());
+    for (uint8_t r = 0; r < LCD_ROWS; r++) {
+        assertEqual(0, memcmp(direct.screen[r], queued.screen[r], LCD_COLS));
+    }
+    assertLess(queued.bytes(), direct.bytes());
+    assertMoreOrEqual(2, queued.commands);
+}
+
+unittest(poll_sends_at_most_the_budget) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setRenderBudget(4);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    uint8_t polls = 0;
+    do {
+        lcd.reset();
+        polls++;
+    } while (menu.poll() && lcd.writes <= 4);
+    assertMoreOrEqual(4, lcd.writes);
+    assertMoreOrEqual(LCD_ROWS * LCD_COLS / 4, polls);
+    assertEqual(">Start service      ", lcd.line(0));
+}
+
+unittest_main()
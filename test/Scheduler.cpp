@@ -0,0 +1,89 @@
+#include <ArduinoUnitTests.h>
+#include <MenuScheduler.h>
+
+#include "MockDisplay.h"
+
+MAIN_MENU(ITEM_BASIC("Start"), ITEM_BASIC("Settings"), ITEM_BASIC("About"));
+
+extern MenuItem* statusMenu[];
+MenuItem* statusMenu[] = {new ItemHeader(), ITEM_BASIC("Ready"),
+                          new ItemFooter()};
+
+unittest(menus_keep_their_own_screen) {
+    MockDisplay lcd, statusLcd;
+    GenericLcdMenu<MockDisplay> menu(4, 20);
+    GenericLcdMenu<MockDisplay> status(2, 16);
+    menu.setRenderBudget(4);
+    status.setRenderBudget(4);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    status.setupLcdWithMenu(statusLcd, statusMenu);
+    MenuScheduler scheduler;
+    assertTrue(scheduler.add(menu));
+    assertTrue(scheduler.add(status));
+    while (scheduler.poll())
+        ;
+    assertEqual(">Start              ", lcd.line(0));
+    assertEqual(" About              ", lcd.line(2));
+    assertEqual(">Ready              ", statusLcd.line(0));
+    menu.down();
+    while (scheduler.poll())
+        ;
+    assertEqual(">Settings           ", lcd.line(1));
+    assertEqual(">Ready              ", statusLcd.line(0));
+}
+
+unittest(budget_is_shared_between_menus) {
+    MockDisplay lcd, statusLcd;
+    lcd.writeMicros = statusLcd.writeMicros = 100;
+    GenericLcdMenu<MockDisplay> menu(4, 20);
+    GenericLcdMenu<MockDisplay> status(2, 16);
+    menu.setRenderBudget(20);
+    status.setRenderBudget(20);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    status.setupLcdWithMenu(statusLcd, statusMenu);
+    lcd.reset();
+    statusLcd.reset();
+    MenuScheduler scheduler(500);
+    scheduler.add(menu);
+    scheduler.add(status);
+    assertTrue(scheduler.poll());
+    assertEqual(5, lcd.writes);
+    assertEqual(0, statusLcd.writes);
+    // the menu left out goes first next time
+    assertTrue(scheduler.poll());
+    assertEqual(5, lcd.writes);
+    assertEqual(5, statusLcd.writes);
+    assertTrue(scheduler.poll());
+    assertEqual(10, lcd.writes);
+    assertEqual(5, statusLcd.writes);
+}
+
+unittest(no_budget_keeps_the_budget_of_each_menu) {
+    MockDisplay lcd, statusLcd;
+    lcd.writeMicros = statusLcd.writeMicros = 100;
+    GenericLcdMenu<MockDisplay> menu(4, 20);
+    GenericLcdMenu<MockDisplay> status(2, 16);
+    menu.setRenderBudget(0, 500);
+    status.setRenderBudget(0, 300);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    status.setupLcdWithMenu(statusLcd, statusMenu);
+    lcd.reset();
+    statusLcd.reset();
+    MenuScheduler scheduler;
+    scheduler.add(menu);
+    scheduler.add(status);
+    assertTrue(scheduler.poll());
+    assertEqual(5, lcd.writes);
+    assertEqual(3, statusLcd.writes);
+}
+
+unittest(at_most_max_menus) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(2, 16);
+    MenuScheduler scheduler;
+    for (uint8_t i = 0; i < MENU_SCHEDULER_MAX_MENUS; i++)
+        assertTrue(scheduler.add(menu));
+    assertFalse(scheduler.add(menu));
+}
+
+unittest_main()
@@ -0,0 +1,90 @@
+#define ENABLE_MENU_STATS
+#include <ArduinoUnitTests.h>
+#include <ItemCommand.h>
+#include <GenericLcdMenu.h>
+
+#include "MockDisplay.h"
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+uint8_t commandCalls = 0;
+void statsCallback() { commandCalls++; }
+
+MAIN_MENU(ITEM_BASIC("Start service"), ITEM_BASIC("Connect to WiFi"),
+          ITEM_COMMAND("Blink SOS", statsCallback), ITEM_BASIC("About"));
+
+unittest(stats_count_draws_and_characters) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    assertEqual(1, menu.getStats().updates);
+    assertEqual(1, menu.getStats().menuDraws);
+    assertEqual(LCD_ROWS, menu.getStats().itemDraws);
+    assertEqual(lcd.writes, menu.getStats().charsWritten);
+    assertEqual(lcd.cursors, menu.getStats().cursorMoves);
+    assertMore(menu.getStats().itemsScanned, 0);
+    assertMore(menu.getStats().virtualCalls, 0);
+}
+
+unittest(stats_reset) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    menu.resetStats();
+    lcd.reset();
+    menu.down();
+    assertEqual(0, menu.getStats().updates);
+    assertEqual(0, menu.getStats().itemDraws);
+    assertEqual(lcd.writes, menu.getStats().charsWritten);
+}
+
+unittest(stats_count_callbacks) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    menu.down();
+    menu.down();
+    menu.enter();
+    assertEqual(1, commandCalls);
+    assertEqual(1, menu.getStats().callbacks);
+    assertMoreOrEqual(menu.getStats().callbackMicros,
+                      menu.getStats().maxCallbackMicros);
+}
+
+unittest(unchanged_items_are_not_drawn_again) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    menu.resetStats();
+    menu.update();
+    assertEqual(1, menu.getStats().menuDraws);
+    assertEqual(0, menu.getStats().itemDraws);
+    mainMenu[1]->markChanged();
+    menu.update();
+    assertEqual(1, menu.getStats().itemDraws);
+}
+
+unittest(hidden_item_updates_its_bit_only) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    menu.resetStats();
+    mainMenu[2]->hide();
+    menu.update();
+    assertEqual(0, menu.getStats().visibilityRebuilds);
+    assertEqual(" Blink SOS     v    ", lcd.line(1));
+    mainMenu[2]->show();
+    menu.update();
+    assertEqual(0, menu.getStats().visibilityRebuilds);
+    assertEqual(" Connect to WiFv    ", lcd.line(1));
+    // more changes than the log holds, every item is checked again
+    for (uint8_t i = 0; i <= MENU_VISIBILITY_LOG_SIZE; i++) {
+        mainMenu[4]->hide();
+        mainMenu[4]->show();
+    }
+    menu.update();
+    assertEqual(1, menu.getStats().visibilityRebuilds);
+}
+
+unittest_main()
@@ -0,0 +1,95 @@
+#include <ArduinoUnitTests.h>
+#include <GenericLcdMenu.h>
+
+#include "MockDisplay.h"
+
+#define LCD_ROWS 2
+#define LCD_COLS 20
+
+MAIN_MENU(ITEM_BASIC("Start service"), ITEM_BASIC("Connect to WiFi"),
+          ITEM_BASIC("Settings"), ITEM_BASIC("About"));
+
+unittest(timeout_is_not_missed_when_loop_is_slow) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu, 1000);
+    delay(999);
+    menu.updateTimer();
+    assertTrue(lcd.isOn);
+    delay(50);
+    menu.updateTimer();
+    assertFalse(lcd.isOn);
+    assertTrue(menu.isAsleep());
+    lcd.reset();
+    menu.updateTimer();
+    delay(100);
+    menu.updateTimer();
+    assertEqual(0, lcd.bytes());
+}
+
+unittest(timeout_survives_millis_overflow) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu, 1000);
+    // started just before millis() overflowed
+    menu.startTime = millis() - 500;
+    menu.updateTimer();
+    assertTrue(lcd.isOn);
+    menu.startTime = millis() - 1001;
+    menu.updateTimer();
+    assertFalse(lcd.isOn);
+}
+
+unittest(backlight_is_dimmed_before_the_display_is_off) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu, 1000);
+    menu.setDimTimeout(500);
+    delay(600);
+    menu.updateTimer();
+    assertTrue(lcd.isOn);
+    assertEqual(LOW, lcd.backlight);
+    menu.down();
+    assertEqual(HIGH, lcd.backlight);
+    delay(600);
+    menu.updateTimer();
+    assertTrue(lcd.isOn);
+    delay(500);
+    menu.updateTimer();
+    assertFalse(lcd.isOn);
+}
+
+unittest(nothing_is_sent_while_asleep) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu, 1000);
+    delay(1000);
+    menu.updateTimer();
+    lcd.reset();
+    mainMenu[1]->markChanged();
+    menu.update();
+    menu.poll();
+    assertEqual(0, lcd.bytes());
+}
+
+unittest(input_wakes_the_display_once) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu, 1000);
+    delay(1000);
+    menu.updateTimer();
+    lcd.reset();
+    menu.down();
+    assertTrue(lcd.isOn);
+    assertFalse(menu.isAsleep());
+    assertEqual(" Start service      ", lcd.line(0));
+    assertEqual(">Connect to WiFi   v", lcd.line(1));
+    // display, backlight, the two cursors and no blink
+    assertEqual(5, lcd.bytes() - lcd.writes);
+    lcd.reset();
+    menu.up();
+    // only noBlink(), no display or backlight command
+    assertEqual(1, lcd.commands);
+}
+
+unittest_main()
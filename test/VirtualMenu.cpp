@@ -0,0 +1,74 @@
+#include <ArduinoUnitTests.h>
+#include <ItemSubMenu.h>
+#include <VirtualMenu.h>
+#include <GenericLcdMenu.h>
+
+#include "MockDisplay.h"
+
+#define LCD_ROWS 2
+#define LCD_COLS 20
+
+uint16_t textCalls = 0;
+uint16_t openedFile = 0;
+
+char* fileName(uint16_t index) {
+    static char name[12];
+    textCalls++;
+    sprintf(name, "File %u", index);
+    return name;
+}
+void openFile(uint16_t index) { openedFile = index; }
+
+extern MenuItem* mainMenu[];
+VirtualMenu files(mainMenu, 1000, fileName, openFile);
+
+MAIN_MENU(ITEM_SUBMENU("Files", files.getMenu()), ITEM_BASIC("About"));
+
+unittest(only_the_window_is_fetched) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    textCalls = 0;
+    menu.enter();
+    // the window is as high as the display
+    assertEqual(LCD_ROWS, files.getRows());
+    assertEqual(">File 0             ", lcd.line(0));
+    assertEqual(" File 1            v", lcd.line(1));
+    assertMore(20, textCalls);
+}
+
+unittest(window_moves_past_its_last_entry) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    menu.enter();
+    for (uint16_t i = 0; i < 500; i++) menu.down();
+    assertEqual(499, files.getOffset());
+    assertEqual(" File 499          ^", lcd.line(0));
+    assertEqual(">File 500          v", lcd.line(1));
+    menu.enter();
+    assertEqual(500, openedFile);
+    for (uint16_t i = 0; i < 600; i++) menu.down();
+    assertEqual(998, files.getOffset());
+    assertEqual(" File 998          ^", lcd.line(0));
+    assertEqual(">File 999           ", lcd.line(1));
+    for (uint16_t i = 0; i < 1000; i++) menu.up();
+    assertEqual(0, files.getOffset());
+    assertEqual(">File 0             ", lcd.line(0));
+    menu.back();
+}
+
+unittest(pages_move_the_window) {
+    MockDisplay lcd;
+    GenericLcdMenu<MockDisplay> menu(LCD_ROWS, LCD_COLS);
+    menu.setupLcdWithMenu(lcd, mainMenu);
+    menu.enter();
+    assertTrue(menu.pageDown());
+    assertTrue(menu.pageDown());
+    assertEqual(">File 4            v", lcd.line(1));
+    assertTrue(menu.pageUp());
+    assertEqual(">File 2            ^", lcd.line(0));
+    menu.back();
+}
+
+unittest_main()